@@ -14,74 +14,278 @@ struct Node* newNode(int key) {
     return n;
 }
 
-// Insert node in BST
+// Insert node in BST (iterative: sorted input makes the tree a list,
+// so the depth can reach n)
 struct Node* insert(struct Node* root, int key) {
-    if (root == NULL)
-        return newNode(key);
-
-    if (key < root->key)
-        root->left = insert(root->left, key);
-    else if (key > root->key)
-        root->right = insert(root->right, key);
-
+    struct Node** link = &root;
+    while (*link != NULL) {
+        if (key < (*link)->key)
+            link = &(*link)->left;
+        else if (key > (*link)->key)
+            link = &(*link)->right;
+        else
+            return root;
+    }
+    *link = newNode(key);
     return root;
 }
 
-// Find smallest node
-struct Node* minValueNode(struct Node* node) {
-    struct Node* current = node;
-    while (current && current->left != NULL)
-        current = current->left;
-    return current;
+// Delete a node (iterative)
+struct Node* deleteNode(struct Node* root, int key) {
+    struct Node** link = &root;
+    while (*link != NULL && (*link)->key != key)
+        link = key < (*link)->key ? &(*link)->left : &(*link)->right;
+
+    struct Node* node = *link;
+    if (node == NULL) return root;
+
+    if (node->left == NULL) {
+        *link = node->right;
+    } else if (node->right == NULL) {
+        *link = node->left;
+    } else {
+        // copy the in-order successor here and unlink it instead
+        struct Node** succLink = &node->right;
+        while ((*succLink)->left != NULL)
+            succLink = &(*succLink)->left;
+        struct Node* succ = *succLink;
+        node->key = succ->key;
+        *succLink = succ->right;
+        node = succ;
+    }
+    free(node);
+    return root;
 }
 
-// Delete a node
-struct Node* deleteNode(struct Node* root, int key) {
-    if (root == NULL) return root;
-
-    if (key < root->key)
-        root->left = deleteNode(root->left, key);
-    else if (key > root->key)
-        root->right = deleteNode(root->right, key);
-    else {
-        if (root->left == NULL) {
-            struct Node* temp = root->right;
-            free(root);
-            return temp;
-        } else if (root->right == NULL) {
-            struct Node* temp = root->left;
+// Free the whole tree without recursion
+void freeTree(struct Node* root) {
+    while (root != NULL) {
+        if (root->left != NULL) {
+            // rotate the left child up until the root has none
+            struct Node* l = root->left;
+            root->left = l->right;
+            l->right = root;
+            root = l;
+        } else {
+            struct Node* next = root->right;
             free(root);
-            return temp;
+            root = next;
         }
+    }
+}
 
-        struct Node* temp = minValueNode(root->right);
-        root->key = temp->key;
-        root->right = deleteNode(root->right, temp->key);
+// In-order iterator with an explicit, heap-allocated stack
+struct BSTIterator {
+    struct Node** stack;
+    int top, cap;
+};
+
+static void iterPush(struct BSTIterator* it, struct Node* n) {
+    if (it->top == it->cap) {
+        it->cap = it->cap ? it->cap * 2 : 64;
+        it->stack = (struct Node**)realloc(it->stack, sizeof(struct Node*) * it->cap);
     }
+    it->stack[it->top++] = n;
+}
 
-    return root;
+// Position the iterator on the smallest key
+void iterBegin(struct BSTIterator* it, struct Node* root) {
+    it->top = 0;
+    for (; root != NULL; root = root->left)
+        iterPush(it, root);
+}
+
+// Position the iterator on the smallest key >= key
+void iterSeek(struct BSTIterator* it, struct Node* root, int key) {
+    it->top = 0;
+    while (root != NULL) {
+        if (root->key < key) {
+            root = root->right;
+        } else {
+            iterPush(it, root);
+            root = root->left;
+        }
+    }
+}
+
+// Return the current node and advance; NULL at the end
+struct Node* iterNext(struct BSTIterator* it) {
+    if (it->top == 0) return NULL;
+    struct Node* n = it->stack[--it->top];
+    for (struct Node* c = n->right; c != NULL; c = c->left)
+        iterPush(it, c);
+    return n;
+}
+
+void iterFree(struct BSTIterator* it) {
+    free(it->stack);
+    it->stack = NULL;
+    it->top = it->cap = 0;
 }
 
 // Traversal functions
+//
+// Keys are written into the caller's buffer; whenever it fills up (and
+// once at the end) flush(buf, count, ctx) consumes it. No recursion:
+// in-order and pre-order are Morris traversals (O(1) extra space, the
+// tree is temporarily threaded and fully restored), post-order uses an
+// explicit heap stack.
+typedef void (*KeySink)(const int* keys, int count, void* ctx);
+
+static void emit(int key, int* buf, int cap, int* used, KeySink flush, void* ctx) {
+    buf[(*used)++] = key;
+    if (*used == cap) {
+        flush(buf, *used, ctx);
+        *used = 0;
+    }
+}
+
+void inorderToBuffer(struct Node* root, int* buf, int cap, KeySink flush, void* ctx) {
+    int used = 0;
+    struct Node* cur = root;
+    while (cur != NULL) {
+        if (cur->left == NULL) {
+            emit(cur->key, buf, cap, &used, flush, ctx);
+            cur = cur->right;
+            continue;
+        }
+        struct Node* pred = cur->left;
+        while (pred->right != NULL && pred->right != cur)
+            pred = pred->right;
+        if (pred->right == NULL) {
+            pred->right = cur;   // thread back to cur
+            cur = cur->left;
+        } else {
+            pred->right = NULL;  // left subtree done: remove the thread
+            emit(cur->key, buf, cap, &used, flush, ctx);
+            cur = cur->right;
+        }
+    }
+    if (used > 0) flush(buf, used, ctx);
+}
+
+void preorderToBuffer(struct Node* root, int* buf, int cap, KeySink flush, void* ctx) {
+    int used = 0;
+    struct Node* cur = root;
+    while (cur != NULL) {
+        if (cur->left == NULL) {
+            emit(cur->key, buf, cap, &used, flush, ctx);
+            cur = cur->right;
+            continue;
+        }
+        struct Node* pred = cur->left;
+        while (pred->right != NULL && pred->right != cur)
+            pred = pred->right;
+        if (pred->right == NULL) {
+            emit(cur->key, buf, cap, &used, flush, ctx);
+            pred->right = cur;
+            cur = cur->left;
+        } else {
+            pred->right = NULL;
+            cur = cur->right;
+        }
+    }
+    if (used > 0) flush(buf, used, ctx);
+}
+
+void postorderToBuffer(struct Node* root, int* buf, int cap, KeySink flush, void* ctx) {
+    int used = 0;
+    struct BSTIterator st = {NULL, 0, 0};   // used only as a growable stack
+    struct Node* last = NULL;
+    struct Node* cur = root;
+    while (cur != NULL || st.top > 0) {
+        if (cur != NULL) {
+            iterPush(&st, cur);
+            cur = cur->left;
+            continue;
+        }
+        struct Node* top = st.stack[st.top - 1];
+        if (top->right != NULL && top->right != last) {
+            cur = top->right;
+        } else {
+            emit(top->key, buf, cap, &used, flush, ctx);
+            last = top;
+            st.top--;
+        }
+    }
+    iterFree(&st);
+    if (used > 0) flush(buf, used, ctx);
+}
+
+static void printKeys(const int* keys, int count, void* ctx) {
+    (void)ctx;
+    for (int i = 0; i < count; i++)
+        printf("%d ", keys[i]);
+}
+
 void inorder(struct Node* root) {
-    if (root == NULL) return;
-    inorder(root->left);
-    printf("%d ", root->key);
-    inorder(root->right);
+    int buf[256];
+    inorderToBuffer(root, buf, 256, printKeys, NULL);
 }
 
 void preorder(struct Node* root) {
-    if (root == NULL) return;
-    printf("%d ", root->key);
-    preorder(root->left);
-    preorder(root->right);
+    int buf[256];
+    preorderToBuffer(root, buf, 256, printKeys, NULL);
 }
 
 void postorder(struct Node* root) {
-    if (root == NULL) return;
-    postorder(root->left);
-    postorder(root->right);
-    printf("%d ", root->key);
+    int buf[256];
+    postorderToBuffer(root, buf, 256, printKeys, NULL);
+}
+
+// Checks that a traversal streams exactly next, next + step, ... in order
+struct SequenceCheck {
+    int next, step;
+    int seen;
+    int ok;
+};
+
+static void checkSequence(const int* keys, int count, void* ctx) {
+    struct SequenceCheck* c = (struct SequenceCheck*)ctx;
+    for (int i = 0; i < count; i++) {
+        c->ok &= keys[i] == c->next;
+        c->next += c->step;
+    }
+    c->seen += count;
+}
+
+// Sorted input degenerates the tree into a list as deep as n. Appending
+// to the end of the chain builds what n calls to insert() would, without
+// their O(n^2) total walk; the last key goes through one full-depth
+// insert(). Ascending keys 0..n-1 lean right, descending ones lean left.
+static struct Node* buildChain(int n, int descending) {
+    struct Node* root = newNode(descending ? n - 1 : 0);
+    struct Node* tail = root;
+    for (int i = 1; i < n - 1; i++) {
+        if (descending) {
+            tail->left = newNode(n - 1 - i);
+            tail = tail->left;
+        } else {
+            tail->right = newNode(i);
+            tail = tail->right;
+        }
+    }
+    return insert(root, descending ? 0 : n - 1);
+}
+
+// Runs every traversal and the iterator over a chain from buildChain()
+static int checkChain(struct Node* root, int n, int descending, int* buf, int cap) {
+    // pre-order follows the chain from the root, post-order the reverse
+    struct SequenceCheck in = {0, 1, 0, 1};
+    struct SequenceCheck pre = {descending ? n - 1 : 0, descending ? -1 : 1, 0, 1};
+    struct SequenceCheck post = {descending ? 0 : n - 1, descending ? 1 : -1, 0, 1};
+    inorderToBuffer(root, buf, cap, checkSequence, &in);
+    preorderToBuffer(root, buf, cap, checkSequence, &pre);
+    postorderToBuffer(root, buf, cap, checkSequence, &post);
+
+    struct BSTIterator it = {NULL, 0, 0};
+    int count = 0, ok = 1;
+    iterBegin(&it, root);
+    for (struct Node* p = iterNext(&it); p != NULL; p = iterNext(&it))
+        ok &= p->key == count++;
+    iterFree(&it);
+    return ok && count == n && in.ok && in.seen == n && pre.ok && pre.seen == n &&
+           post.ok && post.seen == n;
 }
 
 int main() {
@@ -125,5 +329,27 @@ int main() {
     printf("\nPostorder: "); postorder(root);
     printf("\n");
 
+    // iterator: keys >= 45
+    struct BSTIterator it = {NULL, 0, 0};
+    printf("Keys >= 45: ");
+    iterSeek(&it, root, 45);
+    for (struct Node* n = iterNext(&it); n != NULL; n = iterNext(&it))
+        printf("%d ", n->key);
+    printf("\n");
+    iterFree(&it);
+    freeTree(root);
+
+    // degenerate trees: traversals and deletes must not recurse n deep
+    int n = 1000000;
+    int buf[4096];
+    for (int descending = 0; descending <= 1; descending++) {
+        root = buildChain(n, descending);
+        int ok = checkChain(root, n, descending, buf, 4096);
+        root = deleteNode(root, descending ? 0 : n - 1);   // full-depth iterative delete
+        printf("%s degenerate tree of %d keys: in/pre/post-order and iterator %s\n",
+               descending ? "Left" : "Right", n, ok ? "OK" : "FAILED");
+        freeTree(root);
+    }
+
     return 0;
 }
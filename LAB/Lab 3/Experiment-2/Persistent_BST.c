@@ -0,0 +1,387 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <time.h>
+
+// Persistent (path-copying) balanced BST with O(1) snapshots.
+//
+// insert() and deleteNode() never modify a node that is reachable from a
+// published root. They copy the nodes on the search path (plus the few
+// siblings a rotation touches) and return a new root. Every untouched
+// subtree is shared between the old and the new version. AVL balancing
+// keeps the path, and so the extra allocation per update, at O(log n).
+//
+// Each node counts the references to it (parents + root handles). A
+// snapshot is one reference to a root, so taking one is O(1); releasing
+// a version frees exactly the nodes that no other version shares.
+//
+// Compile:
+//   gcc -O2 -pthread -o persistent_bst Persistent_BST.c
+// Run:
+//   ./persistent_bst [keys] [updates] [readers]
+
+struct Node {
+    int key;
+    int height;
+    struct Node *left, *right;
+    _Atomic int refs;
+};
+
+static _Atomic long liveNodes;     // for leak checks
+static _Atomic long allocations;   // nodes created by updates
+
+// Create new node
+struct Node* newNode(int key) {
+    struct Node* n = (struct Node*)malloc(sizeof(struct Node));
+    n->key = key;
+    n->height = 1;
+    n->left = n->right = NULL;
+    atomic_init(&n->refs, 1);
+    atomic_fetch_add_explicit(&liveNodes, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&allocations, 1, memory_order_relaxed);
+    return n;
+}
+
+// Take another reference to a (possibly shared) node
+struct Node* retain(struct Node* n) {
+    if (n)
+        atomic_fetch_add_explicit(&n->refs, 1, memory_order_relaxed);
+    return n;
+}
+
+// Drop a reference; frees the node and releases its children at zero
+void release(struct Node* n) {
+    while (n && atomic_fetch_sub_explicit(&n->refs, 1, memory_order_acq_rel) == 1) {
+        struct Node* right = n->right;
+        release(n->left);
+        free(n);
+        atomic_fetch_sub_explicit(&liveNodes, 1, memory_order_relaxed);
+        n = right;   // loop instead of recursing on the right child
+    }
+}
+
+// Private copy of n that shares n's children
+struct Node* copyNode(struct Node* n) {
+    struct Node* c = newNode(n->key);
+    c->height = n->height;
+    c->left = retain(n->left);
+    c->right = retain(n->right);
+    return c;
+}
+
+// Make *link point to a node that only the (private) parent references
+void own(struct Node** link) {
+    struct Node* n = *link;
+    if (atomic_load_explicit(&n->refs, memory_order_acquire) == 1)
+        return;   // only our private parent can reach it
+    *link = copyNode(n);
+    release(n);
+}
+
+int height(struct Node* n) {
+    return n ? n->height : 0;
+}
+
+int max(int a, int b) {
+    return (a > b) ? a : b;
+}
+
+int getBalance(struct Node* n) {
+    return n ? height(n->left) - height(n->right) : 0;
+}
+
+void updateHeight(struct Node* n) {
+    n->height = 1 + max(height(n->left), height(n->right));
+}
+
+// Rotations only ever run on private nodes
+struct Node* rightRotate(struct Node* y) {
+    struct Node* x = y->left;
+    y->left = x->right;
+    x->right = y;
+    updateHeight(y);
+    updateHeight(x);
+    return x;
+}
+
+struct Node* leftRotate(struct Node* x) {
+    struct Node* y = x->right;
+    x->right = y->left;
+    y->left = x;
+    updateHeight(x);
+    updateHeight(y);
+    return y;
+}
+
+// Rebalance a private node, copying whichever shared children rotate
+struct Node* rebalance(struct Node* n) {
+    updateHeight(n);
+    int balance = getBalance(n);
+    if (balance > 1) {
+        own(&n->left);
+        if (getBalance(n->left) < 0) {
+            own(&n->left->right);
+            n->left = leftRotate(n->left);
+        }
+        return rightRotate(n);
+    }
+    if (balance < -1) {
+        own(&n->right);
+        if (getBalance(n->right) > 0) {
+            own(&n->right->left);
+            n->right = rightRotate(n->right);
+        }
+        return leftRotate(n);
+    }
+    return n;
+}
+
+int search(struct Node* root, int key) {
+    while (root) {
+        if (key == root->key)
+            return 1;
+        root = key < root->key ? root->left : root->right;
+    }
+    return 0;
+}
+
+static struct Node* insertPath(struct Node* node, int key) {
+    if (node == NULL)
+        return newNode(key);
+    struct Node* n = copyNode(node);
+    struct Node** link = key < n->key ? &n->left : &n->right;
+    struct Node* child = insertPath(*link, key);
+    release(*link);
+    *link = child;
+    return rebalance(n);
+}
+
+// Insert into version root; returns a new version (root is unchanged)
+struct Node* insert(struct Node* root, int key) {
+    if (search(root, key))
+        return retain(root);
+    return insertPath(root, key);
+}
+
+static struct Node* deletePath(struct Node* node, int key) {
+    if (key == node->key) {
+        if (node->left == NULL || node->right == NULL)
+            return retain(node->left ? node->left : node->right);
+        // replace by the in-order successor, then delete that on the right
+        struct Node* succ = node->right;
+        while (succ->left)
+            succ = succ->left;
+        struct Node* n = copyNode(node);
+        n->key = succ->key;
+        struct Node* child = deletePath(n->right, succ->key);
+        release(n->right);
+        n->right = child;
+        return rebalance(n);
+    }
+    struct Node* n = copyNode(node);
+    struct Node** link = key < n->key ? &n->left : &n->right;
+    struct Node* child = deletePath(*link, key);
+    release(*link);
+    *link = child;
+    return rebalance(n);
+}
+
+// Delete from version root; returns a new version (root is unchanged)
+struct Node* deleteNode(struct Node* root, int key) {
+    if (!search(root, key))
+        return retain(root);
+    return deletePath(root, key);
+}
+
+// ---------- versions shared between one writer and many readers ----------
+
+struct VersionedTree {
+    pthread_mutex_t lock;   // held only to swap or retain the current root
+    struct Node* current;
+};
+
+// O(1): one extra reference on the current root
+struct Node* snapshot(struct VersionedTree* t) {
+    pthread_mutex_lock(&t->lock);
+    struct Node* r = retain(t->current);
+    pthread_mutex_unlock(&t->lock);
+    return r;
+}
+
+// Make root the current version (takes over the caller's reference)
+void publish(struct VersionedTree* t, struct Node* root) {
+    pthread_mutex_lock(&t->lock);
+    struct Node* old = t->current;
+    t->current = root;
+    pthread_mutex_unlock(&t->lock);
+    release(old);
+}
+
+// ---------- traversals, checks and benchmark ----------
+
+void inorder(struct Node* root) {
+    if (root == NULL) return;
+    inorder(root->left);
+    printf("%d ", root->key);
+    inorder(root->right);
+}
+
+static int toArray(struct Node* root, int* out, int n) {
+    if (root == NULL) return n;
+    n = toArray(root->left, out, n);
+    out[n++] = root->key;
+    return toArray(root->right, out, n);
+}
+
+// Deep copy: what a consistent read costs without persistence
+static struct Node* cloneTree(struct Node* n) {
+    if (n == NULL) return NULL;
+    struct Node* c = newNode(n->key);
+    c->height = n->height;
+    c->left = cloneTree(n->left);
+    c->right = cloneTree(n->right);
+    return c;
+}
+
+static double nowSec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static struct VersionedTree shared = {PTHREAD_MUTEX_INITIALIZER, NULL};
+static _Atomic int writerDone;
+static int keyRange;
+
+struct Reader {
+    pthread_t tid;
+    unsigned int seed;
+    long lookups, snapshots, inconsistent;
+};
+
+static void* readerLoop(void* arg) {
+    struct Reader* r = (struct Reader*)arg;
+    while (!atomic_load(&writerDone)) {
+        struct Node* snap = snapshot(&shared);
+        // the same probe twice on one snapshot must agree
+        int probe = rand_r(&r->seed) % keyRange;
+        int first = search(snap, probe);
+        for (int i = 0; i < 1000; i++)
+            search(snap, rand_r(&r->seed) % keyRange);
+        if (search(snap, probe) != first)
+            r->inconsistent++;
+        r->lookups += 1002;
+        r->snapshots++;
+        release(snap);
+    }
+    return NULL;
+}
+
+int main(int argc, char** argv) {
+    int n = argc > 1 ? atoi(argv[1]) : 1000000;
+    int updates = argc > 2 ? atoi(argv[2]) : 500000;
+    int readers = argc > 3 ? atoi(argv[3]) : 4;
+
+    printf("Creating persistent BST...\n");
+    int keys[] = {50, 30, 70, 20, 40, 60, 80};
+    struct Node* v1 = NULL;
+    for (int i = 0; i < 7; i++) {
+        struct Node* next = insert(v1, keys[i]);
+        release(v1);
+        v1 = next;
+    }
+    struct Node* v2 = deleteNode(v1, 20);
+    struct Node* v3 = deleteNode(v2, 50);
+    printf("Version 1: "); inorder(v1);
+    printf("\nVersion 2 (deleted 20): "); inorder(v2);
+    printf("\nVersion 3 (deleted 50): "); inorder(v3);
+    printf("\n");
+    release(v1);
+    release(v2);
+    release(v3);
+
+    // random updates while keeping every 100th version; old versions must not change
+    int ok = 1;
+    struct Node* saved[50] = {NULL};
+    int* savedKeys[50];
+    int savedCount[50];
+    struct Node* cur = NULL;
+    srand(5);
+    for (int i = 0; i < 5000; i++) {
+        int key = rand() % 2000;
+        struct Node* next = (rand() % 3) ? insert(cur, key) : deleteNode(cur, key);
+        release(cur);
+        cur = next;
+        if (i % 100 == 0) {
+            saved[i / 100] = retain(cur);
+            savedKeys[i / 100] = (int*)malloc(sizeof(int) * 2000);
+            savedCount[i / 100] = toArray(cur, savedKeys[i / 100], 0);
+        }
+    }
+    int* tmp = (int*)malloc(sizeof(int) * 2000);
+    for (int v = 0; v < 50; v++) {
+        int c = toArray(saved[v], tmp, 0);
+        ok &= c == savedCount[v];
+        for (int i = 0; ok && i < c; i++)
+            ok &= tmp[i] == savedKeys[v][i];
+        release(saved[v]);
+        free(savedKeys[v]);
+    }
+    free(tmp);
+    release(cur);
+    printf("Old versions unchanged: %s, leaked nodes: %ld\n", ok ? "OK" : "FAILED", atomic_load(&liveNodes));
+
+    // one writer, N readers, each reading its own snapshot
+    keyRange = 2 * n;
+    struct Node* root = NULL;
+    for (int i = 0; i < n; i++) {
+        struct Node* next = insert(root, (int)((i * 2654435761u) % (unsigned)keyRange));
+        release(root);
+        root = next;
+    }
+    shared.current = root;
+
+    double t0 = nowSec();
+    struct Node* copy = cloneTree(root);
+    double copyTime = nowSec() - t0;
+    release(copy);
+
+    struct Reader* rs = (struct Reader*)calloc(readers, sizeof(struct Reader));
+    atomic_store(&writerDone, 0);
+    for (int i = 0; i < readers; i++) {
+        rs[i].seed = 1234 + i;
+        pthread_create(&rs[i].tid, NULL, readerLoop, &rs[i]);
+    }
+
+    unsigned int seed = 99;
+    atomic_store(&allocations, 0);
+    t0 = nowSec();
+    for (int i = 0; i < updates; i++) {
+        int key = rand_r(&seed) % keyRange;
+        struct Node* base = shared.current;   // only this thread publishes
+        publish(&shared, (i & 1) ? deleteNode(base, key) : insert(base, key));
+    }
+    double writeTime = nowSec() - t0;
+    atomic_store(&writerDone, 1);
+
+    long lookups = 0, snaps = 0, bad = 0;
+    for (int i = 0; i < readers; i++) {
+        pthread_join(rs[i].tid, NULL);
+        lookups += rs[i].lookups;
+        snaps += rs[i].snapshots;
+        bad += rs[i].inconsistent;
+    }
+    release(shared.current);
+    shared.current = NULL;
+
+    printf("\n%d keys, %d updates, %d readers\n", n, updates, readers);
+    printf("writer: %.0f updates/s, %.1f nodes allocated per update\n",
+           updates / writeTime, (double)atomic_load(&allocations) / updates);
+    printf("readers: %.0f lookups/s, %ld snapshots, %ld inconsistent reads\n",
+           lookups / writeTime, snaps, bad);
+    printf("full-copy snapshot of the same tree: %.3f ms (vs O(1) reference)\n", copyTime * 1e3);
+    printf("leaked nodes: %ld\n", atomic_load(&liveNodes));
+    free(rs);
+    return 0;
+}
@@ -0,0 +1,390 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <limits.h>
+
+// Interval tree on top of the AVL tree of AVL-Tree_Operations.c.
+//
+// Each node stores a closed interval [lo, hi] and is ordered by (lo, hi).
+// maxHi is the largest hi in the node's subtree; rightRotate/leftRotate
+// and every rebalance recompute it together with the height, so it stays
+// correct through insertion and deletion.
+//
+// A subtree whose maxHi is below the query start cannot contain an
+// overlap, and nothing right of a node whose lo is past the query end
+// can either. Stabbing and overlap queries prune on both and write their
+// k results into a caller-supplied buffer. This is the CLRS augmentation,
+// not an output-sensitive structure: a walk also visits the ancestors of
+// each result that do not overlap themselves, so a query costs
+// O(min(n, k log n)) rather than O(log n + k). It is close to log n + k
+// when the results are few or clustered; many long intervals scattered
+// among short ones are the bad case. A true O(log n + k) bound needs a
+// centered interval tree or a priority search tree instead of maxHi.
+//
+// Compile:
+//   gcc -O2 -o avl_interval AVL-Interval_Tree.c
+// Run:
+//   ./avl_interval [intervals] [queries]
+
+struct Interval {
+    int lo, hi;
+};
+
+// Node structure
+struct Node {
+    int lo, hi;
+    int maxHi;
+    int height;
+    struct Node *left;
+    struct Node *right;
+};
+
+int height(struct Node *N) {
+    if (N == NULL)
+        return 0;
+    return N->height;
+}
+
+int max(int a, int b) {
+    return (a > b) ? a : b;
+}
+
+// Recompute height and maxHi from the children
+void update(struct Node *N) {
+    N->height = max(height(N->left), height(N->right)) + 1;
+    N->maxHi = N->hi;
+    if (N->left && N->left->maxHi > N->maxHi)
+        N->maxHi = N->left->maxHi;
+    if (N->right && N->right->maxHi > N->maxHi)
+        N->maxHi = N->right->maxHi;
+}
+
+struct Node* newNode(int lo, int hi) {
+    struct Node* node = (struct Node*)malloc(sizeof(struct Node));
+    node->lo = lo;
+    node->hi = hi;
+    node->maxHi = hi;
+    node->left = NULL;
+    node->right = NULL;
+    node->height = 1;
+    return node;
+}
+
+// Order intervals by lo, then hi
+int compare(int lo, int hi, struct Node* n) {
+    if (lo != n->lo)
+        return lo < n->lo ? -1 : 1;
+    if (hi != n->hi)
+        return hi < n->hi ? -1 : 1;
+    return 0;
+}
+
+// Right rotation
+struct Node* rightRotate(struct Node* y) {
+    struct Node* x = y->left;
+    struct Node* T2 = x->right;
+
+    x->right = y;
+    y->left = T2;
+
+    update(y);
+    update(x);
+
+    return x;
+}
+
+// Left rotation
+struct Node* leftRotate(struct Node* x) {
+    struct Node* y = x->right;
+    struct Node* T2 = y->left;
+
+    y->left = x;
+    x->right = T2;
+
+    update(x);
+    update(y);
+
+    return y;
+}
+
+int getBalance(struct Node* N) {
+    if (N == NULL)
+        return 0;
+    return height(N->left) - height(N->right);
+}
+
+// Restore the AVL property at node (children already valid)
+struct Node* rebalance(struct Node* node) {
+    update(node);
+    int balance = getBalance(node);
+
+    if (balance > 1 && getBalance(node->left) >= 0)
+        return rightRotate(node);
+
+    if (balance > 1 && getBalance(node->left) < 0) {
+        node->left = leftRotate(node->left);
+        return rightRotate(node);
+    }
+
+    if (balance < -1 && getBalance(node->right) <= 0)
+        return leftRotate(node);
+
+    if (balance < -1 && getBalance(node->right) > 0) {
+        node->right = rightRotate(node->right);
+        return leftRotate(node);
+    }
+
+    return node;
+}
+
+// Insert [lo, hi]; duplicates are ignored
+struct Node* insert(struct Node* node, int lo, int hi) {
+    if (node == NULL)
+        return newNode(lo, hi);
+
+    int c = compare(lo, hi, node);
+    if (c < 0)
+        node->left = insert(node->left, lo, hi);
+    else if (c > 0)
+        node->right = insert(node->right, lo, hi);
+    else
+        return node;
+
+    return rebalance(node);
+}
+
+struct Node* minValueNode(struct Node* node) {
+    struct Node* current = node;
+    while (current->left != NULL)
+        current = current->left;
+    return current;
+}
+
+// Delete [lo, hi]
+struct Node* deleteNode(struct Node* root, int lo, int hi) {
+    if (root == NULL)
+        return root;
+
+    int c = compare(lo, hi, root);
+    if (c < 0)
+        root->left = deleteNode(root->left, lo, hi);
+    else if (c > 0)
+        root->right = deleteNode(root->right, lo, hi);
+    else {
+        if ((root->left == NULL) || (root->right == NULL)) {
+            struct Node* temp = root->left ? root->left : root->right;
+            free(root);
+            return temp;
+        }
+        struct Node* temp = minValueNode(root->right);
+        root->lo = temp->lo;
+        root->hi = temp->hi;
+        root->right = deleteNode(root->right, temp->lo, temp->hi);
+    }
+
+    return rebalance(root);
+}
+
+// Build a balanced tree from intervals sorted by (lo, hi) in O(n)
+struct Node* buildSorted(const struct Interval* iv, int lo, int hi) {
+    if (lo > hi)
+        return NULL;
+    int mid = lo + (hi - lo) / 2;
+    struct Node* node = newNode(iv[mid].lo, iv[mid].hi);
+    node->left = buildSorted(iv, lo, mid - 1);
+    node->right = buildSorted(iv, mid + 1, hi);
+    update(node);
+    return node;
+}
+
+// All intervals overlapping [a, b]. Writes at most cap of them to out
+// and returns how many there are in total (more than cap: retry bigger).
+static void overlapRec(struct Node* node, int a, int b, struct Interval* out, int cap, int* count) {
+    while (node != NULL && node->maxHi >= a) {
+        if (node->left && node->left->maxHi >= a)
+            overlapRec(node->left, a, b, out, cap, count);
+        if (node->lo > b)
+            return;   // this node and its right subtree start after b
+        if (node->hi >= a) {
+            if (*count < cap) {
+                out[*count].lo = node->lo;
+                out[*count].hi = node->hi;
+            }
+            (*count)++;
+        }
+        node = node->right;
+    }
+}
+
+int overlap(struct Node* root, int a, int b, struct Interval* out, int cap) {
+    int count = 0;
+    overlapRec(root, a, b, out, cap, &count);
+    return count;
+}
+
+// All intervals containing point
+int stab(struct Node* root, int point, struct Interval* out, int cap) {
+    return overlap(root, point, point, out, cap);
+}
+
+void inorder(struct Node* root) {
+    if (root != NULL) {
+        inorder(root->left);
+        printf("[%d,%d] ", root->lo, root->hi);
+        inorder(root->right);
+    }
+}
+
+void freeTree(struct Node* root) {
+    if (root == NULL) return;
+    freeTree(root->left);
+    freeTree(root->right);
+    free(root);
+}
+
+// ---------- checks and benchmark ----------
+
+// Returns maxHi of the subtree (INT_MIN if empty); clears *ok when the
+// height, balance or maxHi of any node is wrong
+static int checkTree(struct Node* n, int* ok) {
+    if (n == NULL)
+        return INT_MIN;
+    int l = checkTree(n->left, ok), r = checkTree(n->right, ok);
+    int m = max(n->hi, max(l, r));
+    if (m != n->maxHi || n->height != max(height(n->left), height(n->right)) + 1 ||
+        getBalance(n) > 1 || getBalance(n) < -1)
+        *ok = 0;
+    return n->maxHi;
+}
+
+static int bruteOverlap(const struct Interval* iv, int n, int a, int b, struct Interval* out, int cap) {
+    int count = 0;
+    for (int i = 0; i < n; i++) {
+        if (iv[i].lo <= b && iv[i].hi >= a) {
+            if (count < cap)
+                out[count] = iv[i];
+            count++;
+        }
+    }
+    return count;
+}
+
+static int cmpInterval(const void* x, const void* y) {
+    const struct Interval* p = (const struct Interval*)x;
+    const struct Interval* q = (const struct Interval*)y;
+    if (p->lo != q->lo) return p->lo < q->lo ? -1 : 1;
+    if (p->hi != q->hi) return p->hi < q->hi ? -1 : 1;
+    return 0;
+}
+
+static double nowSec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+int main(int argc, char** argv) {
+    int n = argc > 1 ? atoi(argv[1]) : 1000000;
+    int q = argc > 2 ? atoi(argv[2]) : 2000;
+    struct Node* root = NULL;
+    struct Interval out[64];
+
+    int demo[][2] = {{15, 20}, {10, 30}, {17, 19}, {5, 20}, {12, 15}, {30, 40}};
+    for (int i = 0; i < 6; i++)
+        root = insert(root, demo[i][0], demo[i][1]);
+    printf("Intervals: ");
+    inorder(root);
+    int k = stab(root, 18, out, 64);
+    printf("\nContaining 18:");
+    for (int i = 0; i < k; i++)
+        printf(" [%d,%d]", out[i].lo, out[i].hi);
+    root = deleteNode(root, 10, 30);
+    k = overlap(root, 21, 31, out, 64);
+    printf("\nAfter deleting [10,30], overlapping [21,31]:");
+    for (int i = 0; i < k; i++)
+        printf(" [%d,%d]", out[i].lo, out[i].hi);
+    printf("\n");
+    freeTree(root);
+
+    // time ranges: random starts over [0, 1e9), mostly short, a few long
+    srand(7);
+    struct Interval* iv = (struct Interval*)malloc(sizeof(struct Interval) * n);
+    for (int i = 0; i < n; i++) {
+        int lo = (int)(((long long)rand() * RAND_MAX + rand()) % 1000000000);
+        int len = rand() % 100 == 0 ? rand() % 10000000 : rand() % 10000;
+        iv[i].lo = lo;
+        iv[i].hi = lo + len;
+    }
+
+    double t0 = nowSec();
+    root = NULL;
+    for (int i = 0; i < n; i++)
+        root = insert(root, iv[i].lo, iv[i].hi);
+    double tInsert = nowSec() - t0;
+
+    qsort(iv, n, sizeof(struct Interval), cmpInterval);
+    int m = 0;   // drop duplicates, as insert() does
+    for (int i = 0; i < n; i++)
+        if (m == 0 || cmpInterval(&iv[m - 1], &iv[i]) != 0)
+            iv[m++] = iv[i];
+    n = m;
+
+    t0 = nowSec();
+    struct Node* built = buildSorted(iv, 0, n - 1);
+    double tBuild = nowSec() - t0;
+
+    int ok = 1;
+    checkTree(root, &ok);
+    checkTree(built, &ok);
+
+    // random windows of up to 100000 and single points
+    int* qa = (int*)malloc(sizeof(int) * q);
+    int* qb = (int*)malloc(sizeof(int) * q);
+    for (int i = 0; i < q; i++) {
+        qa[i] = (int)(((long long)rand() * RAND_MAX + rand()) % 1000000000);
+        qb[i] = i % 2 ? qa[i] : qa[i] + rand() % 100000;
+    }
+    struct Interval* buf = (struct Interval*)malloc(sizeof(struct Interval) * 4096);
+    struct Interval* bruteBuf = (struct Interval*)malloc(sizeof(struct Interval) * 4096);
+    long found = 0, bruteFound = 0;
+
+    t0 = nowSec();
+    for (int i = 0; i < q; i++)
+        found += overlap(built, qa[i], qb[i], buf, 4096);
+    double tTree = nowSec() - t0;
+
+    t0 = nowSec();
+    for (int i = 0; i < q; i++)
+        bruteFound += bruteOverlap(iv, n, qa[i], qb[i], bruteBuf, 4096);
+    double tBrute = nowSec() - t0;
+
+    // both return results in (lo, hi) order, so the buffers must match
+    for (int i = 0; i < q && ok; i++) {
+        int c1 = overlap(root, qa[i], qb[i], buf, 4096);
+        int c2 = bruteOverlap(iv, n, qa[i], qb[i], bruteBuf, 4096);
+        ok = c1 == c2;
+        for (int j = 0; ok && j < c1 && j < 4096; j++)
+            ok = cmpInterval(&buf[j], &bruteBuf[j]) == 0;
+    }
+
+    // delete half and re-check the augmentation
+    for (int i = 0; i < n; i += 2)
+        root = deleteNode(root, iv[i].lo, iv[i].hi);
+    checkTree(root, &ok);
+
+    printf("\n%d intervals: insert %.3f s, bulk build from sorted %.3f s\n", n, tInsert, tBuild);
+    printf("%d queries, %.1f results per query\n", q, (double)found / q);
+    printf("interval tree: %.2f us/query, brute-force scan: %.2f us/query, speedup %.0fx\n",
+           tTree / q * 1e6, tBrute / q * 1e6, tBrute / tTree);
+    printf("results match brute force, maxHi valid after deletes: %s\n",
+           ok && found == bruteFound ? "OK" : "FAILED");
+
+    freeTree(root);
+    freeTree(built);
+    free(iv);
+    free(qa);
+    free(qb);
+    free(buf);
+    free(bruteBuf);
+    return 0;
+}
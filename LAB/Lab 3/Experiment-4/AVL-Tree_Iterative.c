@@ -0,0 +1,472 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+
+// Non-recursive AVL tree with a node arena.
+//
+// insert/delete walk down once, remembering the address of every child
+// link on the way in an explicit path stack, then retrace that stack
+// bottom-up and stop as soon as a subtree's height no longer changes.
+// Nodes come from large slabs; freed nodes go on a free list threaded
+// through their left pointer, so there is no malloc/free per operation.
+//
+// The recursive insert()/deleteNode() from AVL-Tree_Operations.c are kept
+// below (as insertRec/deleteNodeRec) for the benchmark in main().
+//
+// Compile:
+//   gcc -O2 -o avl_iterative AVL-Tree_Iterative.c
+// Run:
+//   ./avl_iterative [keys]
+
+#define MAX_HEIGHT 64        // AVL height <= 1.44 log2(n + 2), plenty for 2^32 nodes
+#define SLAB_NODES 65536     // nodes per arena slab
+
+// Node structure
+struct Node {
+    int key;
+    struct Node *left;
+    struct Node *right;
+    int height;
+};
+
+// Slab of nodes handed out by the arena
+struct Slab {
+    struct Slab *next;
+    struct Node nodes[SLAB_NODES];
+};
+
+struct NodeArena {
+    struct Slab *slabs;
+    struct Node *freeList;   // recycled nodes, linked through ->left
+    int used;                // nodes handed out from the newest slab
+};
+
+struct AVLTree {
+    struct Node *root;
+    struct NodeArena arena;
+};
+
+// Get height of a node
+int height(struct Node *N) {
+    if (N == NULL)
+        return 0;
+    return N->height;
+}
+
+// Get max of two integers
+int max(int a, int b) {
+    return (a > b) ? a : b;
+}
+
+// Take a node from the free list or the current slab
+struct Node *arenaAlloc(struct NodeArena *a) {
+    struct Node *node = a->freeList;
+    if (node != NULL) {
+        a->freeList = node->left;
+        return node;
+    }
+    if (a->slabs == NULL || a->used == SLAB_NODES) {
+        struct Slab *s = (struct Slab *)malloc(sizeof(struct Slab));
+        s->next = a->slabs;
+        a->slabs = s;
+        a->used = 0;
+    }
+    return &a->slabs->nodes[a->used++];
+}
+
+// Return a node to the free list
+void arenaFree(struct NodeArena *a, struct Node *node) {
+    node->left = a->freeList;
+    a->freeList = node;
+}
+
+// Release every slab at once
+void arenaDestroy(struct NodeArena *a) {
+    while (a->slabs) {
+        struct Slab *next = a->slabs->next;
+        free(a->slabs);
+        a->slabs = next;
+    }
+    a->freeList = NULL;
+    a->used = 0;
+}
+
+// New node (from the arena)
+struct Node *newNodeArena(struct NodeArena *a, int key) {
+    struct Node *node = arenaAlloc(a);
+    node->key = key;
+    node->left = NULL;
+    node->right = NULL;
+    node->height = 1;
+    return node;
+}
+
+// Right rotation
+struct Node *rightRotate(struct Node *y) {
+    struct Node *x = y->left;
+    struct Node *T2 = x->right;
+
+    x->right = y;
+    y->left = T2;
+
+    y->height = max(height(y->left), height(y->right)) + 1;
+    x->height = max(height(x->left), height(x->right)) + 1;
+
+    return x;
+}
+
+// Left rotation
+struct Node *leftRotate(struct Node *x) {
+    struct Node *y = x->right;
+    struct Node *T2 = y->left;
+
+    y->left = x;
+    x->right = T2;
+
+    x->height = max(height(x->left), height(x->right)) + 1;
+    y->height = max(height(y->left), height(y->right)) + 1;
+
+    return y;
+}
+
+// Get balance factor
+int getBalance(struct Node *N) {
+    if (N == NULL)
+        return 0;
+    return height(N->left) - height(N->right);
+}
+
+// Restore the AVL property at node and return the new subtree root
+struct Node *rebalance(struct Node *node) {
+    node->height = 1 + max(height(node->left), height(node->right));
+    int balance = getBalance(node);
+
+    if (balance > 1) {
+        if (getBalance(node->left) < 0)
+            node->left = leftRotate(node->left);
+        return rightRotate(node);
+    }
+    if (balance < -1) {
+        if (getBalance(node->right) > 0)
+            node->right = rightRotate(node->right);
+        return leftRotate(node);
+    }
+    return node;
+}
+
+// Walk the path stack upwards, stop once a subtree height is unchanged
+void retrace(struct Node ***path, int depth) {
+    while (depth > 0) {
+        struct Node **link = path[--depth];
+        struct Node *node = *link;
+        int oldHeight = node->height;
+        *link = rebalance(node);
+        if ((*link)->height == oldHeight)
+            break;
+    }
+}
+
+// Iterative insert: returns 1 if the key was added
+int insertIter(struct AVLTree *t, int key) {
+    struct Node **path[MAX_HEIGHT];
+    int depth = 0;
+    struct Node **link = &t->root;
+
+    while (*link != NULL) {
+        struct Node *node = *link;
+        path[depth++] = link;
+        if (key < node->key)
+            link = &node->left;
+        else if (key > node->key)
+            link = &node->right;
+        else
+            return 0;
+    }
+    *link = newNodeArena(&t->arena, key);
+    retrace(path, depth);
+    return 1;
+}
+
+// Iterative delete: returns 1 if the key was removed
+int deleteIter(struct AVLTree *t, int key) {
+    struct Node **path[MAX_HEIGHT];
+    int depth = 0;
+    struct Node **link = &t->root;
+
+    while (*link != NULL && (*link)->key != key) {
+        path[depth++] = link;
+        link = key < (*link)->key ? &(*link)->left : &(*link)->right;
+    }
+    if (*link == NULL)
+        return 0;
+
+    struct Node *target = *link;
+    if (target->left != NULL && target->right != NULL) {
+        // copy the in-order successor up and remove it instead
+        path[depth++] = link;
+        link = &target->right;
+        while ((*link)->left != NULL) {
+            path[depth++] = link;
+            link = &(*link)->left;
+        }
+        target->key = (*link)->key;
+    }
+
+    struct Node *victim = *link;
+    *link = victim->left ? victim->left : victim->right;
+    arenaFree(&t->arena, victim);
+    retrace(path, depth);
+    return 1;
+}
+
+// Iterative search
+int searchIter(struct Node *node, int key) {
+    while (node != NULL) {
+        if (key == node->key)
+            return 1;
+        node = key < node->key ? node->left : node->right;
+    }
+    return 0;
+}
+
+// ---------- recursive reference (AVL-Tree_Operations.c) ----------
+
+struct Node *newNode(int key) {
+    struct Node *node = (struct Node *)malloc(sizeof(struct Node));
+    node->key = key;
+    node->left = NULL;
+    node->right = NULL;
+    node->height = 1;
+    return node;
+}
+
+struct Node *insertRec(struct Node *node, int key) {
+    if (node == NULL)
+        return newNode(key);
+
+    if (key < node->key)
+        node->left = insertRec(node->left, key);
+    else if (key > node->key)
+        node->right = insertRec(node->right, key);
+    else
+        return node;
+
+    node->height = 1 + max(height(node->left), height(node->right));
+    int balance = getBalance(node);
+
+    if (balance > 1 && key < node->left->key)
+        return rightRotate(node);
+    if (balance < -1 && key > node->right->key)
+        return leftRotate(node);
+    if (balance > 1 && key > node->left->key) {
+        node->left = leftRotate(node->left);
+        return rightRotate(node);
+    }
+    if (balance < -1 && key < node->right->key) {
+        node->right = rightRotate(node->right);
+        return leftRotate(node);
+    }
+    return node;
+}
+
+struct Node *minValueNode(struct Node *node) {
+    struct Node *current = node;
+    while (current->left != NULL)
+        current = current->left;
+    return current;
+}
+
+struct Node *deleteNodeRec(struct Node *root, int key) {
+    if (root == NULL)
+        return root;
+
+    if (key < root->key)
+        root->left = deleteNodeRec(root->left, key);
+    else if (key > root->key)
+        root->right = deleteNodeRec(root->right, key);
+    else {
+        if ((root->left == NULL) || (root->right == NULL)) {
+            struct Node *temp = root->left ? root->left : root->right;
+            if (temp == NULL) {
+                temp = root;
+                root = NULL;
+            } else
+                *root = *temp;
+            free(temp);
+        } else {
+            struct Node *temp = minValueNode(root->right);
+            root->key = temp->key;
+            root->right = deleteNodeRec(root->right, temp->key);
+        }
+    }
+
+    if (root == NULL)
+        return root;
+
+    root->height = 1 + max(height(root->left), height(root->right));
+    int balance = getBalance(root);
+
+    if (balance > 1 && getBalance(root->left) >= 0)
+        return rightRotate(root);
+    if (balance > 1 && getBalance(root->left) < 0) {
+        root->left = leftRotate(root->left);
+        return rightRotate(root);
+    }
+    if (balance < -1 && getBalance(root->right) <= 0)
+        return leftRotate(root);
+    if (balance < -1 && getBalance(root->right) > 0) {
+        root->right = rightRotate(root->right);
+        return leftRotate(root);
+    }
+    return root;
+}
+
+void freeTree(struct Node *root) {
+    if (root == NULL)
+        return;
+    freeTree(root->left);
+    freeTree(root->right);
+    free(root);
+}
+
+// ---------- checks and benchmark ----------
+
+// In-order traversal
+void inorder(struct Node *root) {
+    if (root != NULL) {
+        inorder(root->left);
+        printf("%d ", root->key);
+        inorder(root->right);
+    }
+}
+
+// Verify ordering, stored heights and balance; returns height or -1
+int checkAVL(struct Node *node, long lo, long hi) {
+    if (node == NULL)
+        return 0;
+    if (node->key <= lo || node->key >= hi)
+        return -1;
+    int l = checkAVL(node->left, lo, node->key);
+    int r = checkAVL(node->right, node->key, hi);
+    if (l < 0 || r < 0 || l - r > 1 || r - l > 1 || node->height != max(l, r) + 1)
+        return -1;
+    return node->height;
+}
+
+static double nowSec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void shuffle(int *a, int n, unsigned int seed) {
+    srand(seed);
+    for (int i = n - 1; i > 0; i--) {
+        int j = (int)(((unsigned long)rand() * (RAND_MAX + 1UL) + rand()) % (unsigned long)(i + 1));
+        int t = a[i]; a[i] = a[j]; a[j] = t;
+    }
+}
+
+// Runs in a child process so ru_maxrss is per implementation (both
+// children start from the same baseline: the key arrays of the parent)
+static void runBench(int iterative, int n, int *keys, int *order) {
+    double t0 = nowSec(), tIns, tDel;
+    if (iterative) {
+        struct AVLTree t = {NULL, {NULL, NULL, 0}};
+        for (int i = 0; i < n; i++)
+            insertIter(&t, keys[i]);
+        tIns = nowSec() - t0;
+        t0 = nowSec();
+        for (int i = 0; i < n; i++)
+            deleteIter(&t, keys[order[i]]);
+        tDel = nowSec() - t0;
+        arenaDestroy(&t.arena);
+    } else {
+        struct Node *root = NULL;
+        for (int i = 0; i < n; i++)
+            root = insertRec(root, keys[i]);
+        tIns = nowSec() - t0;
+        t0 = nowSec();
+        for (int i = 0; i < n; i++)
+            root = deleteNodeRec(root, keys[order[i]]);
+        tDel = nowSec() - t0;
+    }
+    printf("%-10s %14.0f %14.0f", iterative ? "iterative" : "recursive", n / tIns, n / tDel);
+    fflush(stdout);
+}
+
+int main(int argc, char **argv) {
+    int n = argc > 1 ? atoi(argv[1]) : 2000000;
+    struct AVLTree t = {NULL, {NULL, NULL, 0}};
+
+    printf("Inserting nodes...\n");
+    insertIter(&t, 10);
+    insertIter(&t, 20);
+    insertIter(&t, 30);
+    insertIter(&t, 40);
+    insertIter(&t, 50);
+    insertIter(&t, 25);
+
+    printf("Inorder traversal of the AVL tree:\n");
+    inorder(t.root);
+
+    deleteIter(&t, 40);
+    printf("\nAfter deleting 40:\n");
+    inorder(t.root);
+    printf("\n");
+    arenaDestroy(&t.arena);
+
+    // randomized cross-check against the recursive version
+    int ok = 1;
+    struct Node *ref = NULL;
+    t.root = NULL;
+    srand(7);
+    for (int i = 0; i < 200000 && ok; i++) {
+        int key = rand() % 5000;
+        if (rand() % 3) {
+            insertIter(&t, key);
+            ref = insertRec(ref, key);
+        } else {
+            deleteIter(&t, key);
+            ref = deleteNodeRec(ref, key);
+        }
+        if (i % 1000 == 0)
+            ok = checkAVL(t.root, -1, 1L << 40) >= 0 && height(t.root) == height(ref);
+    }
+    for (int k = 0; k < 5000 && ok; k++)
+        ok = searchIter(t.root, k) == searchIter(ref, k);
+    printf("Cross-check with recursive AVL: %s\n", ok ? "OK" : "FAILED");
+    arenaDestroy(&t.arena);
+    freeTree(ref);
+
+    int *keys = (int *)malloc(sizeof(int) * n);
+    int *order = (int *)malloc(sizeof(int) * n);
+    for (int i = 0; i < n; i++) {
+        keys[i] = i * 2;
+        order[i] = i;
+    }
+    shuffle(keys, n, 1);
+    shuffle(order, n, 2);
+
+    printf("\n%d random inserts, then %d random deletes\n", n, n);
+    printf("%-10s %14s %14s %14s\n", "version", "inserts/sec", "deletes/sec", "peak RSS (MB)");
+    for (int iterative = 0; iterative <= 1; iterative++) {
+        fflush(stdout);
+        pid_t pid = fork();
+        if (pid == 0) {
+            runBench(iterative, n, keys, order);
+            _exit(0);
+        }
+        int status;
+        struct rusage ru;
+        wait4(pid, &status, 0, &ru);
+        printf(" %14.1f\n", ru.ru_maxrss / 1024.0);
+    }
+
+    free(keys);
+    free(order);
+    return 0;
+}
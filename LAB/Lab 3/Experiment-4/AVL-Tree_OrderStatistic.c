@@ -0,0 +1,387 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+// Order-statistic AVL tree.
+//
+// Every node also stores the size of its subtree. rightRotate/leftRotate
+// and insert/deleteNode recompute it alongside the height, which gives
+//   rank(key)            number of keys smaller than key
+//   select_kth(k)        k-th smallest key (1-based; select() is taken by libc)
+//   count_range(lo, hi)  number of keys in [lo, hi]
+// in O(log n) instead of an O(n) inorder() walk.
+//
+// Compile:
+//   gcc -O2 -o avl_order_statistic AVL-Tree_OrderStatistic.c
+// Run:
+//   ./avl_order_statistic [keys] [queries]
+
+// Node structure
+struct Node {
+    int key;
+    struct Node *left;
+    struct Node *right;
+    int height;
+    int size;   // number of nodes in this subtree
+};
+
+// Get height of a node
+int height(struct Node *N) {
+    if (N == NULL)
+        return 0;
+    return N->height;
+}
+
+// Get subtree size of a node
+int size(struct Node *N) {
+    if (N == NULL)
+        return 0;
+    return N->size;
+}
+
+// Get max of two integers
+int max(int a, int b) {
+    return (a > b) ? a : b;
+}
+
+// Recompute height and size from the children
+void update(struct Node *N) {
+    N->height = max(height(N->left), height(N->right)) + 1;
+    N->size = size(N->left) + size(N->right) + 1;
+}
+
+// New node
+struct Node* newNode(int key) {
+    struct Node* node = (struct Node*)malloc(sizeof(struct Node));
+    node->key = key;
+    node->left = NULL;
+    node->right = NULL;
+    node->height = 1;
+    node->size = 1;
+    return node;
+}
+
+// Right rotation
+struct Node* rightRotate(struct Node* y) {
+    struct Node* x = y->left;
+    struct Node* T2 = x->right;
+
+    x->right = y;
+    y->left = T2;
+
+    update(y);
+    update(x);
+
+    return x;
+}
+
+// Left rotation
+struct Node* leftRotate(struct Node* x) {
+    struct Node* y = x->right;
+    struct Node* T2 = y->left;
+
+    y->left = x;
+    x->right = T2;
+
+    update(x);
+    update(y);
+
+    return y;
+}
+
+// Get balance factor
+int getBalance(struct Node* N) {
+    if (N == NULL)
+        return 0;
+    return height(N->left) - height(N->right);
+}
+
+// Insert function
+struct Node* insert(struct Node* node, int key) {
+    if (node == NULL)
+        return newNode(key);
+
+    if (key < node->key)
+        node->left = insert(node->left, key);
+    else if (key > node->key)
+        node->right = insert(node->right, key);
+    else
+        return node;
+
+    update(node);
+
+    int balance = getBalance(node);
+
+    // Left Left Case
+    if (balance > 1 && key < node->left->key)
+        return rightRotate(node);
+
+    // Right Right Case
+    if (balance < -1 && key > node->right->key)
+        return leftRotate(node);
+
+    // Left Right Case
+    if (balance > 1 && key > node->left->key) {
+        node->left = leftRotate(node->left);
+        return rightRotate(node);
+    }
+
+    // Right Left Case
+    if (balance < -1 && key < node->right->key) {
+        node->right = rightRotate(node->right);
+        return leftRotate(node);
+    }
+
+    return node;
+}
+
+// Find the smallest node
+struct Node* minValueNode(struct Node* node) {
+    struct Node* current = node;
+    while (current->left != NULL)
+        current = current->left;
+    return current;
+}
+
+// Delete function
+struct Node* deleteNode(struct Node* root, int key) {
+    if (root == NULL)
+        return root;
+
+    if (key < root->key)
+        root->left = deleteNode(root->left, key);
+    else if (key > root->key)
+        root->right = deleteNode(root->right, key);
+    else {
+        if ((root->left == NULL) || (root->right == NULL)) {
+            struct Node* temp = root->left ? root->left : root->right;
+            if (temp == NULL) {
+                temp = root;
+                root = NULL;
+            } else
+                *root = *temp;
+            free(temp);
+        } else {
+            struct Node* temp = minValueNode(root->right);
+            root->key = temp->key;
+            root->right = deleteNode(root->right, temp->key);
+        }
+    }
+
+    if (root == NULL)
+        return root;
+
+    update(root);
+    int balance = getBalance(root);
+
+    if (balance > 1 && getBalance(root->left) >= 0)
+        return rightRotate(root);
+
+    if (balance > 1 && getBalance(root->left) < 0) {
+        root->left = leftRotate(root->left);
+        return rightRotate(root);
+    }
+
+    if (balance < -1 && getBalance(root->right) <= 0)
+        return leftRotate(root);
+
+    if (balance < -1 && getBalance(root->right) > 0) {
+        root->right = rightRotate(root->right);
+        return leftRotate(root);
+    }
+
+    return root;
+}
+
+// Number of keys smaller than key
+int rank(struct Node* root, int key) {
+    int r = 0;
+    while (root != NULL) {
+        if (key <= root->key)
+            root = root->left;
+        else {
+            r += size(root->left) + 1;
+            root = root->right;
+        }
+    }
+    return r;
+}
+
+// k-th smallest key (1-based). Returns 0 if k is out of range.
+int select_kth(struct Node* root, int k, int *key) {
+    if (k < 1 || k > size(root))
+        return 0;
+    while (root != NULL) {
+        int leftSize = size(root->left);
+        if (k == leftSize + 1) {
+            *key = root->key;
+            return 1;
+        }
+        if (k <= leftSize)
+            root = root->left;
+        else {
+            k -= leftSize + 1;
+            root = root->right;
+        }
+    }
+    return 0;
+}
+
+// Number of keys in [lo, hi]
+int count_range(struct Node* root, int lo, int hi) {
+    if (lo > hi)
+        return 0;
+    // keys <= hi minus keys < lo; hi + 1 would overflow at INT_MAX
+    int upto = rank(root, hi);
+    struct Node* p = root;
+    while (p != NULL && p->key != hi)
+        p = hi < p->key ? p->left : p->right;
+    if (p != NULL)
+        upto++;
+    return upto - rank(root, lo);
+}
+
+// In-order traversal
+void inorder(struct Node* root) {
+    if (root != NULL) {
+        inorder(root->left);
+        printf("%d ", root->key);
+        inorder(root->right);
+    }
+}
+
+void freeTree(struct Node* root) {
+    if (root == NULL)
+        return;
+    freeTree(root->left);
+    freeTree(root->right);
+    free(root);
+}
+
+// ---------- traversal-based versions, for comparison ----------
+
+// Count keys below key with an in-order walk
+void walkRank(struct Node* root, int key, int *count) {
+    if (root == NULL)
+        return;
+    walkRank(root->left, key, count);
+    if (root->key < key)
+        (*count)++;
+    walkRank(root->right, key, count);
+}
+
+// Stop the walk at the k-th key
+void walkSelect(struct Node* root, int *k, int *key) {
+    if (root == NULL || *k <= 0)
+        return;
+    walkSelect(root->left, k, key);
+    if (*k > 0 && --(*k) == 0)
+        *key = root->key;
+    walkSelect(root->right, k, key);
+}
+
+void walkRange(struct Node* root, int lo, int hi, int *count) {
+    if (root == NULL)
+        return;
+    walkRange(root->left, lo, hi, count);
+    if (root->key >= lo && root->key <= hi)
+        (*count)++;
+    walkRange(root->right, lo, hi, count);
+}
+
+static double nowSec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+int main(int argc, char **argv) {
+    int n = argc > 1 ? atoi(argv[1]) : 1000000;
+    int q = argc > 2 ? atoi(argv[2]) : 200;
+    struct Node* root = NULL;
+    int key;
+
+    printf("Inserting nodes...\n");
+    root = insert(root, 10);
+    root = insert(root, 20);
+    root = insert(root, 30);
+    root = insert(root, 40);
+    root = insert(root, 50);
+    root = insert(root, 25);
+
+    printf("Inorder traversal of the AVL tree:\n");
+    inorder(root);
+
+    root = deleteNode(root, 40);
+    printf("\nAfter deleting 40:\n");
+    inorder(root);
+
+    printf("\nrank(30) = %d\n", rank(root, 30));
+    if (select_kth(root, 2, &key))
+        printf("select_kth(2) = %d\n", key);
+    printf("count_range(15, 45) = %d\n", count_range(root, 15, 45));
+    freeTree(root);
+
+    // random tree of even keys, cross-checked against the walks
+    root = NULL;
+    srand(1);
+    for (int i = 0; i < n; i++)
+        root = insert(root, (int)(((unsigned)rand() * 2654435761u) % (unsigned)(4 * n)) * 2);
+    n = size(root);
+
+    int *qs = (int *)malloc(sizeof(int) * q);
+    for (int i = 0; i < q; i++)
+        qs[i] = rand() % (8 * n);
+
+    int ok = 1;
+    for (int i = 0; i < q && i < 20; i++) {
+        int a = 0, b = 0, k = qs[i] % n + 1, s1 = 0, s2 = -1;
+        walkRank(root, qs[i], &a);
+        ok &= a == rank(root, qs[i]);
+        walkRange(root, qs[i], qs[i] + 1000, &b);
+        ok &= b == count_range(root, qs[i], qs[i] + 1000);
+        select_kth(root, k, &s1);
+        walkSelect(root, &k, &s2);
+        ok &= s1 == s2;
+    }
+    printf("\nCross-check with in-order walks: %s\n", ok ? "OK" : "FAILED");
+
+    printf("%d keys, %d queries each\n", n, q);
+    printf("%-12s %16s %16s %10s\n", "query", "tree (ns/op)", "walk (ns/op)", "speedup");
+    for (int op = 0; op < 3; op++) {
+        volatile long sink = 0;
+        int reps = 10000;   // tree queries are fast; repeat them for a stable timing
+        double t0 = nowSec();
+        for (int r = 0; r < reps; r++)
+            for (int i = 0; i < q; i++) {
+                if (op == 0)
+                    sink += rank(root, qs[i]);
+                else if (op == 1) {
+                    int s = 0;
+                    select_kth(root, qs[i] % n + 1, &s);
+                    sink += s;
+                } else
+                    sink += count_range(root, qs[i], qs[i] + n);
+            }
+        double tree = (nowSec() - t0) / ((double)reps * q) * 1e9;
+
+        t0 = nowSec();
+        for (int i = 0; i < q; i++) {
+            int c = 0, k = qs[i] % n + 1;
+            if (op == 0)
+                walkRank(root, qs[i], &c);
+            else if (op == 1)
+                walkSelect(root, &k, &c);
+            else
+                walkRange(root, qs[i], qs[i] + n, &c);
+            sink += c;
+        }
+        double walk = (nowSec() - t0) / q * 1e9;
+        const char *names[] = {"rank", "select", "count_range"};
+        printf("%-12s %16.1f %16.1f %10.0f\n", names[op], tree, walk, walk / tree);
+    }
+
+    free(qs);
+    freeTree(root);
+    return 0;
+}
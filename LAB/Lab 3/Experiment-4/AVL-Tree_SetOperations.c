@@ -0,0 +1,570 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+
+// Join-based set operations on AVL trees, run in parallel.
+//
+// join(L, k, R) glues two AVL trees around a middle node k (all keys of L
+// are smaller than k, all keys of R larger) in O(|h(L) - h(R)|). split
+// and the set operations are built on top of join only:
+//   unionTrees, intersectTrees, differenceTrees
+// do O(m log(n/m + 1)) work for trees of sizes m <= n, and the two
+// recursive halves are independent, so they are handed to a small
+// fork-join pool. The operations are destructive: the input trees are
+// consumed and their nodes reused for the result.
+//
+// Compile:
+//   gcc -O2 -pthread -o avl_set_ops AVL-Tree_SetOperations.c
+// Run:
+//   ./avl_set_ops [keys_per_set] [max_threads]
+
+#define MIN_PARALLEL_HEIGHT 12   // do not fork below ~4K-node subtrees
+#define MAX_TASKS 4096
+
+// Node structure
+struct Node {
+    int key;
+    struct Node *left;
+    struct Node *right;
+    int height;
+};
+
+// Get height of a node
+int height(struct Node *N) {
+    if (N == NULL)
+        return 0;
+    return N->height;
+}
+
+// Get max of two integers
+int max(int a, int b) {
+    return (a > b) ? a : b;
+}
+
+// New node
+struct Node *newNode(int key) {
+    struct Node *node = (struct Node *)malloc(sizeof(struct Node));
+    node->key = key;
+    node->left = NULL;
+    node->right = NULL;
+    node->height = 1;
+    return node;
+}
+
+// Attach children to node and fix its height
+struct Node *makeNode(struct Node *l, struct Node *k, struct Node *r) {
+    k->left = l;
+    k->right = r;
+    k->height = max(height(l), height(r)) + 1;
+    return k;
+}
+
+// Right rotation
+struct Node *rightRotate(struct Node *y) {
+    struct Node *x = y->left;
+    struct Node *T2 = x->right;
+
+    x->right = y;
+    y->left = T2;
+
+    y->height = max(height(y->left), height(y->right)) + 1;
+    x->height = max(height(x->left), height(x->right)) + 1;
+
+    return x;
+}
+
+// Left rotation
+struct Node *leftRotate(struct Node *x) {
+    struct Node *y = x->right;
+    struct Node *T2 = y->left;
+
+    y->left = x;
+    x->right = T2;
+
+    x->height = max(height(x->left), height(x->right)) + 1;
+    y->height = max(height(y->left), height(y->right)) + 1;
+
+    return y;
+}
+
+// ---------- join / split ----------
+
+// L is taller than R by more than one: walk down L's right spine
+static struct Node *joinRight(struct Node *l, struct Node *k, struct Node *r) {
+    struct Node *ll = l->left, *c = l->right;
+    if (height(c) <= height(r) + 1) {
+        struct Node *t = makeNode(c, k, r);
+        if (height(t) <= height(ll) + 1)
+            return makeNode(ll, l, t);
+        return leftRotate(makeNode(ll, l, rightRotate(t)));
+    }
+    struct Node *t = joinRight(c, k, r);
+    struct Node *t2 = makeNode(ll, l, t);
+    if (height(t) <= height(ll) + 1)
+        return t2;
+    return leftRotate(t2);
+}
+
+// Mirror image of joinRight
+static struct Node *joinLeft(struct Node *l, struct Node *k, struct Node *r) {
+    struct Node *rr = r->right, *c = r->left;
+    if (height(c) <= height(l) + 1) {
+        struct Node *t = makeNode(l, k, c);
+        if (height(t) <= height(rr) + 1)
+            return makeNode(t, r, rr);
+        return rightRotate(makeNode(leftRotate(t), r, rr));
+    }
+    struct Node *t = joinLeft(l, k, c);
+    struct Node *t2 = makeNode(t, r, rr);
+    if (height(t) <= height(rr) + 1)
+        return t2;
+    return rightRotate(t2);
+}
+
+// Join L < k < R into one AVL tree
+struct Node *join(struct Node *l, struct Node *k, struct Node *r) {
+    if (height(l) > height(r) + 1)
+        return joinRight(l, k, r);
+    if (height(r) > height(l) + 1)
+        return joinLeft(l, k, r);
+    return makeNode(l, k, r);
+}
+
+// Split T into keys < key and keys > key. Returns the node holding key
+// (detached) or NULL if key is absent.
+struct Node *split(struct Node *t, int key, struct Node **l, struct Node **r) {
+    if (t == NULL) {
+        *l = *r = NULL;
+        return NULL;
+    }
+    struct Node *tl = t->left, *tr = t->right, *found;
+    if (key == t->key) {
+        *l = tl;
+        *r = tr;
+        t->left = t->right = NULL;
+        t->height = 1;
+        return t;
+    }
+    if (key < t->key) {
+        found = split(tl, key, l, r);
+        *r = join(*r, t, tr);
+    } else {
+        found = split(tr, key, l, r);
+        *l = join(tl, t, *l);
+    }
+    return found;
+}
+
+// Detach the largest node of t; the rest goes to *rest
+static struct Node *splitLast(struct Node *t, struct Node **rest) {
+    if (t->right == NULL) {
+        *rest = t->left;
+        return t;
+    }
+    struct Node *sub;
+    struct Node *last = splitLast(t->right, &sub);
+    *rest = join(t->left, t, sub);
+    return last;
+}
+
+// Join two trees with all keys of l below all keys of r
+struct Node *join2(struct Node *l, struct Node *r) {
+    if (l == NULL)
+        return r;
+    struct Node *rest;
+    struct Node *k = splitLast(l, &rest);
+    return join(rest, k, r);
+}
+
+void freeTree(struct Node *root) {
+    if (root == NULL)
+        return;
+    freeTree(root->left);
+    freeTree(root->right);
+    free(root);
+}
+
+// ---------- fork-join pool ----------
+
+struct Task {
+    void (*fn)(void *);
+    void *arg;
+    int where;           // 0 not queued, 1 in the queue, 2 taken (guarded by pool.lock)
+    _Atomic int done;
+};
+
+static struct {
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+    struct Task *stack[MAX_TASKS];
+    int top;
+    int stop;
+    int nworkers;
+    pthread_t *workers;  // nworkers of them, allocated by poolInit
+} pool = {.lock = PTHREAD_MUTEX_INITIALIZER, .wake = PTHREAD_COND_INITIALIZER};
+
+static void runTask(struct Task *t) {
+    t->fn(t->arg);
+    atomic_store_explicit(&t->done, 1, memory_order_release);
+}
+
+// Take the newest queued task (pool.lock must be held)
+static struct Task *takeTopLocked(void) {
+    struct Task *t = pool.stack[--pool.top];
+    t->where = 2;
+    return t;
+}
+
+static void *workerLoop(void *arg) {
+    (void)arg;
+    for (;;) {
+        pthread_mutex_lock(&pool.lock);
+        while (pool.top == 0 && !pool.stop)
+            pthread_cond_wait(&pool.wake, &pool.lock);
+        if (pool.stop) {
+            pthread_mutex_unlock(&pool.lock);
+            return NULL;
+        }
+        struct Task *t = takeTopLocked();
+        pthread_mutex_unlock(&pool.lock);
+        runTask(t);
+    }
+}
+
+// Start nthreads - 1 workers; the calling thread is the last one
+void poolInit(int nthreads) {
+    pool.top = 0;
+    pool.stop = 0;
+    pool.nworkers = nthreads > 1 ? nthreads - 1 : 0;
+    pool.workers = (pthread_t *)malloc(sizeof(pthread_t) * (pool.nworkers ? pool.nworkers : 1));
+    for (int i = 0; i < pool.nworkers; i++)
+        pthread_create(&pool.workers[i], NULL, workerLoop, NULL);
+}
+
+void poolShutdown(void) {
+    pthread_mutex_lock(&pool.lock);
+    pool.stop = 1;
+    pthread_cond_broadcast(&pool.wake);
+    pthread_mutex_unlock(&pool.lock);
+    for (int i = 0; i < pool.nworkers; i++)
+        pthread_join(pool.workers[i], NULL);
+    free(pool.workers);
+    pool.workers = NULL;
+    pool.nworkers = 0;
+}
+
+// Offer a task to idle workers. If nobody takes it, joinTask runs it.
+void forkTask(struct Task *t, void (*fn)(void *), void *arg) {
+    t->fn = fn;
+    t->arg = arg;
+    t->where = 0;
+    atomic_init(&t->done, 0);
+    if (pool.nworkers == 0)
+        return;
+    pthread_mutex_lock(&pool.lock);
+    if (pool.top < MAX_TASKS) {
+        t->where = 1;
+        pool.stack[pool.top++] = t;
+        pthread_cond_signal(&pool.wake);
+    }
+    pthread_mutex_unlock(&pool.lock);
+}
+
+// Wait for t. If no worker has taken it yet it is pulled back out of the
+// queue and run inline; otherwise help with other queued tasks meanwhile.
+void joinTask(struct Task *t) {
+    int taken;
+    pthread_mutex_lock(&pool.lock);
+    if (t->where == 1) {
+        int i = pool.top - 1;
+        while (pool.stack[i] != t)
+            i--;
+        for (; i < pool.top - 1; i++)
+            pool.stack[i] = pool.stack[i + 1];
+        pool.top--;
+        t->where = 0;
+    }
+    taken = t->where == 2;
+    pthread_mutex_unlock(&pool.lock);
+
+    if (!taken) {
+        runTask(t);
+        return;
+    }
+    while (!atomic_load_explicit(&t->done, memory_order_acquire)) {
+        struct Task *other = NULL;
+        pthread_mutex_lock(&pool.lock);
+        if (pool.top > 0)
+            other = takeTopLocked();
+        pthread_mutex_unlock(&pool.lock);
+        if (other != NULL)
+            runTask(other);
+        else
+            sched_yield();
+    }
+}
+
+// ---------- set operations ----------
+
+enum { OP_UNION, OP_INTERSECT, OP_DIFFERENCE };
+
+struct SetArgs {
+    int op;
+    struct Node *a, *b, *result;
+};
+
+static struct Node *setOp(int op, struct Node *a, struct Node *b);
+
+static void setOpTask(void *p) {
+    struct SetArgs *s = (struct SetArgs *)p;
+    s->result = setOp(s->op, s->a, s->b);
+}
+
+// Recurse on (a1, b1) and (a2, b2), in parallel when the trees are big
+static void recurseBoth(int op, struct Node *a1, struct Node *b1, struct Node **r1,
+                        struct Node *a2, struct Node *b2, struct Node **r2) {
+    if (pool.nworkers > 0 && max(height(a1), height(b1)) >= MIN_PARALLEL_HEIGHT) {
+        struct Task task;
+        struct SetArgs right = {op, a2, b2, NULL};
+        forkTask(&task, setOpTask, &right);
+        *r1 = setOp(op, a1, b1);
+        joinTask(&task);
+        *r2 = right.result;
+    } else {
+        *r1 = setOp(op, a1, b1);
+        *r2 = setOp(op, a2, b2);
+    }
+}
+
+static struct Node *setOp(int op, struct Node *a, struct Node *b) {
+    struct Node *l, *r, *tl, *tr, *found;
+
+    if (op == OP_UNION) {
+        if (a == NULL) return b;
+        if (b == NULL) return a;
+        found = split(b, a->key, &l, &r);
+        free(found);   // duplicate of a's root (or NULL)
+        recurseBoth(op, a->left, l, &tl, a->right, r, &tr);
+        return join(tl, a, tr);
+    }
+
+    if (op == OP_INTERSECT) {
+        if (a == NULL || b == NULL) {
+            freeTree(a);
+            freeTree(b);
+            return NULL;
+        }
+        found = split(b, a->key, &l, &r);
+        recurseBoth(op, a->left, l, &tl, a->right, r, &tr);
+        if (found) {
+            free(found);
+            return join(tl, a, tr);
+        }
+        free(a);
+        return join2(tl, tr);
+    }
+
+    // OP_DIFFERENCE: keys of a that are not in b
+    if (a == NULL) {
+        freeTree(b);
+        return NULL;
+    }
+    if (b == NULL)
+        return a;
+    found = split(a, b->key, &l, &r);
+    free(found);
+    recurseBoth(op, l, b->left, &tl, r, b->right, &tr);
+    free(b);
+    return join2(tl, tr);
+}
+
+struct Node *unionTrees(struct Node *a, struct Node *b) { return setOp(OP_UNION, a, b); }
+struct Node *intersectTrees(struct Node *a, struct Node *b) { return setOp(OP_INTERSECT, a, b); }
+struct Node *differenceTrees(struct Node *a, struct Node *b) { return setOp(OP_DIFFERENCE, a, b); }
+
+// ---------- helpers, reference insert and benchmark ----------
+
+// Perfectly balanced tree from sorted keys
+struct Node *buildBalanced(const int *keys, int lo, int hi) {
+    if (lo > hi)
+        return NULL;
+    int mid = lo + (hi - lo) / 2;
+    struct Node *node = newNode(keys[mid]);
+    return makeNode(buildBalanced(keys, lo, mid - 1), node, buildBalanced(keys, mid + 1, hi));
+}
+
+int getBalance(struct Node *N) {
+    if (N == NULL)
+        return 0;
+    return height(N->left) - height(N->right);
+}
+
+// Insert function (AVL-Tree_Operations.c), used as the baseline
+struct Node *insert(struct Node *node, int key) {
+    if (node == NULL)
+        return newNode(key);
+    if (key < node->key)
+        node->left = insert(node->left, key);
+    else if (key > node->key)
+        node->right = insert(node->right, key);
+    else
+        return node;
+
+    node->height = 1 + max(height(node->left), height(node->right));
+    int balance = getBalance(node);
+    if (balance > 1 && key < node->left->key)
+        return rightRotate(node);
+    if (balance < -1 && key > node->right->key)
+        return leftRotate(node);
+    if (balance > 1 && key > node->left->key) {
+        node->left = leftRotate(node->left);
+        return rightRotate(node);
+    }
+    if (balance < -1 && key < node->right->key) {
+        node->right = rightRotate(node->right);
+        return leftRotate(node);
+    }
+    return node;
+}
+
+// In-order traversal
+void inorder(struct Node *root) {
+    if (root != NULL) {
+        inorder(root->left);
+        printf("%d ", root->key);
+        inorder(root->right);
+    }
+}
+
+// Copy keys in order into out; returns the count
+static int toArray(struct Node *root, int *out, int n) {
+    if (root == NULL)
+        return n;
+    n = toArray(root->left, out, n);
+    out[n++] = root->key;
+    return toArray(root->right, out, n);
+}
+
+// Verify ordering, heights and balance; returns height or -1
+static int checkAVL(struct Node *node) {
+    if (node == NULL)
+        return 0;
+    int l = checkAVL(node->left), r = checkAVL(node->right);
+    if (l < 0 || r < 0 || l - r > 1 || r - l > 1 || node->height != max(l, r) + 1)
+        return -1;
+    if ((node->left && node->left->key >= node->key) || (node->right && node->right->key <= node->key))
+        return -1;
+    return node->height;
+}
+
+// Reference result of a set operation on sorted arrays
+static int mergeArrays(int op, const int *a, int na, const int *b, int nb, int *out) {
+    int i = 0, j = 0, n = 0;
+    while (i < na || j < nb) {
+        if (j == nb || (i < na && a[i] < b[j])) {
+            if (op != OP_INTERSECT) out[n++] = a[i];
+            i++;
+        } else if (i == na || b[j] < a[i]) {
+            if (op == OP_UNION) out[n++] = b[j];
+            j++;
+        } else {
+            if (op != OP_DIFFERENCE) out[n++] = a[i];
+            i++;
+            j++;
+        }
+    }
+    return n;
+}
+
+static double nowSec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// Sorted random keys: every value in [0, 4n) with probability 1/4
+static int makeSet(int *out, int n, unsigned int seed) {
+    int count = 0;
+    srand(seed);
+    for (int k = 0; count < n && k < 8 * n; k++)
+        if (rand() % 4 == 0)
+            out[count++] = k;
+    return count;
+}
+
+int main(int argc, char **argv) {
+    int n = argc > 1 ? atoi(argv[1]) : 2000000;
+    int maxThreads = argc > 2 ? atoi(argv[2]) : 16;
+    int small1[] = {10, 20, 30, 40, 50}, small2[] = {5, 20, 25, 50, 60};
+
+    struct Node *u = unionTrees(buildBalanced(small1, 0, 4), buildBalanced(small2, 0, 4));
+    printf("Union: ");
+    inorder(u);
+    freeTree(u);
+    u = intersectTrees(buildBalanced(small1, 0, 4), buildBalanced(small2, 0, 4));
+    printf("\nIntersection: ");
+    inorder(u);
+    freeTree(u);
+    u = differenceTrees(buildBalanced(small1, 0, 4), buildBalanced(small2, 0, 4));
+    printf("\nDifference: ");
+    inorder(u);
+    printf("\n");
+    freeTree(u);
+
+    int *a = (int *)malloc(sizeof(int) * n);
+    int *b = (int *)malloc(sizeof(int) * n);
+    int *expect = (int *)malloc(sizeof(int) * 2 * n);
+    int *got = (int *)malloc(sizeof(int) * 2 * n);
+    int na = makeSet(a, n, 1), nb = makeSet(b, n, 2);
+    const char *names[] = {"union", "intersection", "difference"};
+
+    // correctness with the pool running
+    poolInit(maxThreads < 4 ? maxThreads : 4);
+    for (int op = 0; op < 3; op++) {
+        struct Node *r = setOp(op, buildBalanced(a, 0, na - 1), buildBalanced(b, 0, nb - 1));
+        int ne = mergeArrays(op, a, na, b, nb, expect);
+        int ng = toArray(r, got, 0);
+        int ok = ng == ne && checkAVL(r) >= 0;
+        for (int i = 0; ok && i < ne; i++)
+            ok = got[i] == expect[i];
+        printf("Check %-12s: %s\n", names[op], ok ? "OK" : "FAILED");
+        freeTree(r);
+    }
+    poolShutdown();
+
+    // baseline: insert every key of b into a, one insert() at a time
+    struct Node *base = buildBalanced(a, 0, na - 1);
+    double t0 = nowSec();
+    for (int i = 0; i < nb; i++)
+        base = insert(base, b[i]);
+    double tInsert = nowSec() - t0;
+    freeTree(base);
+    printf("\n%d + %d keys; union by repeated insert(): %.3f s\n", na, nb, tInsert);
+
+    printf("%-12s %8s %10s %10s\n", "operation", "threads", "time (s)", "speedup");
+    for (int op = 0; op < 3; op++) {
+        double seq = 0;
+        for (int threads = 1; threads <= maxThreads; threads *= 2) {
+            struct Node *x = buildBalanced(a, 0, na - 1);
+            struct Node *y = buildBalanced(b, 0, nb - 1);
+            poolInit(threads);
+            t0 = nowSec();
+            struct Node *r = setOp(op, x, y);
+            double t = nowSec() - t0;
+            poolShutdown();
+            if (threads == 1)
+                seq = t;
+            printf("%-12s %8d %10.3f %10.2f\n", names[op], threads, t, seq / t);
+            freeTree(r);
+        }
+    }
+
+    free(a);
+    free(b);
+    free(expect);
+    free(got);
+    return 0;
+}
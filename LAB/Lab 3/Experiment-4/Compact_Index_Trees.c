@@ -0,0 +1,556 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+#include <malloc.h>
+
+// Compact, pooled AVL and BST nodes.
+//
+// All nodes of a tree live in one contiguous array and refer to their
+// children by 32-bit index instead of a 64-bit pointer. Index 0 is NIL.
+// For the AVL the balance factor (-1, 0, +1) needs only 2 bits, so it is
+// packed into the top bits of the left index, leaving 30 bits (about one
+// billion nodes) for the index itself:
+//
+//   struct CNode { int key; uint32_t left; uint32_t right; }   12 bytes
+//
+// versus struct Node of AVL-Tree_Operations.c (32 bytes with padding, 48
+// per node once malloc's chunk overhead is included).
+// rebuild() re-lays a tree out in DFS (pre-order) order so that a parent
+// and its left child are adjacent and subtrees occupy contiguous ranges.
+//
+// Compile:
+//   gcc -O2 -o compact_trees Compact_Index_Trees.c
+// Run:
+//   ./compact_trees [keys] [lookups]
+
+#define NIL 0u
+#define IDX_MASK 0x3FFFFFFFu
+#define BF_SHIFT 30
+
+struct CNode {
+    int key;
+    uint32_t left;    // bits 0..29 left child index, bits 30..31 balance code
+    uint32_t right;   // right child index
+};
+
+struct NodePool {
+    struct CNode *nodes;
+    uint32_t cap;
+    uint32_t used;       // next never-used slot
+    uint32_t freeHead;   // free list, linked through left
+};
+
+// ---------- pool ----------
+
+void poolInit(struct NodePool *p, uint32_t cap) {
+    if (cap < 2)
+        cap = 2;
+    p->nodes = (struct CNode *)malloc(sizeof(struct CNode) * cap);
+    p->cap = cap;
+    p->used = 1;   // slot 0 is NIL
+    p->freeHead = NIL;
+}
+
+void poolDestroy(struct NodePool *p) {
+    free(p->nodes);
+    p->nodes = NULL;
+    p->cap = p->used = 0;
+    p->freeHead = NIL;
+}
+
+uint32_t poolAlloc(struct NodePool *p, int key) {
+    uint32_t i = p->freeHead;
+    if (i != NIL) {
+        p->freeHead = p->nodes[i].left;
+    } else {
+        if (p->used == p->cap) {
+            p->cap = p->cap * 2 > IDX_MASK ? IDX_MASK : p->cap * 2;
+            p->nodes = (struct CNode *)realloc(p->nodes, sizeof(struct CNode) * p->cap);
+        }
+        i = p->used++;
+    }
+    p->nodes[i].key = key;
+    p->nodes[i].left = NIL;
+    p->nodes[i].right = NIL;
+    return i;
+}
+
+void poolFree(struct NodePool *p, uint32_t i) {
+    p->nodes[i].left = p->freeHead;
+    p->freeHead = i;
+}
+
+// ---------- packed field access ----------
+
+static inline uint32_t getLeft(struct NodePool *p, uint32_t i) { return p->nodes[i].left & IDX_MASK; }
+static inline uint32_t getRight(struct NodePool *p, uint32_t i) { return p->nodes[i].right; }
+
+static inline void setLeft(struct NodePool *p, uint32_t i, uint32_t child) {
+    p->nodes[i].left = (p->nodes[i].left & ~IDX_MASK) | child;
+}
+static inline void setRight(struct NodePool *p, uint32_t i, uint32_t child) {
+    p->nodes[i].right = child;
+}
+
+// Balance factor height(right) - height(left); codes 0 -> 0, 1 -> -1, 2 -> +1
+static inline int getBF(struct NodePool *p, uint32_t i) {
+    static const int decode[4] = {0, -1, 1, 0};
+    return decode[p->nodes[i].left >> BF_SHIFT];
+}
+static inline void setBF(struct NodePool *p, uint32_t i, int bf) {
+    uint32_t code = bf == 0 ? 0u : (bf < 0 ? 1u : 2u);
+    p->nodes[i].left = (p->nodes[i].left & IDX_MASK) | (code << BF_SHIFT);
+}
+
+// ---------- AVL (balance factors instead of heights) ----------
+
+static uint32_t rotateRight(struct NodePool *p, uint32_t y) {
+    uint32_t x = getLeft(p, y);
+    setLeft(p, y, getRight(p, x));
+    setRight(p, x, y);
+    return x;
+}
+
+static uint32_t rotateLeft(struct NodePool *p, uint32_t x) {
+    uint32_t y = getRight(p, x);
+    setRight(p, x, getLeft(p, y));
+    setLeft(p, y, x);
+    return y;
+}
+
+// n is two levels left-heavy. Rotate and fix balance factors. *shorter
+// tells whether the subtree lost height compared with before the fix.
+static uint32_t fixLeftHeavy(struct NodePool *p, uint32_t n, int *shorter) {
+    uint32_t l = getLeft(p, n);
+    int bl = getBF(p, l);
+    if (bl <= 0) {
+        uint32_t r = rotateRight(p, n);
+        setBF(p, n, bl == 0 ? -1 : 0);
+        setBF(p, l, bl == 0 ? 1 : 0);
+        *shorter = bl != 0;
+        return r;
+    }
+    uint32_t lr = getRight(p, l);
+    int b = getBF(p, lr);
+    setLeft(p, n, rotateLeft(p, l));
+    uint32_t r = rotateRight(p, n);
+    setBF(p, n, b < 0 ? 1 : 0);
+    setBF(p, l, b > 0 ? -1 : 0);
+    setBF(p, lr, 0);
+    *shorter = 1;
+    return r;
+}
+
+// Mirror image of fixLeftHeavy
+static uint32_t fixRightHeavy(struct NodePool *p, uint32_t n, int *shorter) {
+    uint32_t r = getRight(p, n);
+    int br = getBF(p, r);
+    if (br >= 0) {
+        uint32_t t = rotateLeft(p, n);
+        setBF(p, n, br == 0 ? 1 : 0);
+        setBF(p, r, br == 0 ? -1 : 0);
+        *shorter = br != 0;
+        return t;
+    }
+    uint32_t rl = getLeft(p, r);
+    int b = getBF(p, rl);
+    setRight(p, n, rotateRight(p, r));
+    uint32_t t = rotateLeft(p, n);
+    setBF(p, n, b > 0 ? -1 : 0);
+    setBF(p, r, b < 0 ? 1 : 0);
+    setBF(p, rl, 0);
+    *shorter = 1;
+    return t;
+}
+
+// Insert key below n; *grew is set if the subtree got taller
+uint32_t avlInsert(struct NodePool *p, uint32_t n, int key, int *grew) {
+    int shorter;
+    if (n == NIL) {
+        *grew = 1;
+        return poolAlloc(p, key);
+    }
+    int k = p->nodes[n].key;
+    if (key == k) {
+        *grew = 0;
+        return n;
+    }
+    if (key < k) {
+        uint32_t c = avlInsert(p, getLeft(p, n), key, grew);
+        setLeft(p, n, c);
+        if (!*grew)
+            return n;
+        int bf = getBF(p, n) - 1;
+        if (bf < -1) {
+            *grew = 0;
+            return fixLeftHeavy(p, n, &shorter);
+        }
+        setBF(p, n, bf);
+        *grew = bf != 0;
+        return n;
+    }
+    uint32_t c = avlInsert(p, getRight(p, n), key, grew);
+    setRight(p, n, c);
+    if (!*grew)
+        return n;
+    int bf = getBF(p, n) + 1;
+    if (bf > 1) {
+        *grew = 0;
+        return fixRightHeavy(p, n, &shorter);
+    }
+    setBF(p, n, bf);
+    *grew = bf != 0;
+    return n;
+}
+
+// Delete key below n; *shrunk is set if the subtree got shorter
+uint32_t avlDelete(struct NodePool *p, uint32_t n, int key, int *shrunk) {
+    if (n == NIL) {
+        *shrunk = 0;
+        return NIL;
+    }
+    int k = p->nodes[n].key;
+    int leftSide;
+    if (key < k) {
+        setLeft(p, n, avlDelete(p, getLeft(p, n), key, shrunk));
+        leftSide = 1;
+    } else if (key > k) {
+        setRight(p, n, avlDelete(p, getRight(p, n), key, shrunk));
+        leftSide = 0;
+    } else if (getLeft(p, n) == NIL || getRight(p, n) == NIL) {
+        uint32_t child = getLeft(p, n) != NIL ? getLeft(p, n) : getRight(p, n);
+        poolFree(p, n);
+        *shrunk = 1;
+        return child;
+    } else {
+        // take the in-order successor's key, then delete it on the right
+        uint32_t s = getRight(p, n);
+        while (getLeft(p, s) != NIL)
+            s = getLeft(p, s);
+        p->nodes[n].key = p->nodes[s].key;
+        setRight(p, n, avlDelete(p, getRight(p, n), p->nodes[s].key, shrunk));
+        leftSide = 0;
+    }
+    if (!*shrunk)
+        return n;
+
+    int bf = getBF(p, n) + (leftSide ? 1 : -1);
+    if (bf > 1)
+        return fixRightHeavy(p, n, shrunk);
+    if (bf < -1)
+        return fixLeftHeavy(p, n, shrunk);
+    setBF(p, n, bf);
+    *shrunk = bf == 0;
+    return n;
+}
+
+// ---------- plain BST on the same pool (balance bits unused) ----------
+
+uint32_t bstInsert(struct NodePool *p, uint32_t root, int key) {
+    if (root == NIL)
+        return poolAlloc(p, key);
+    uint32_t cur = root;
+    for (;;) {
+        int k = p->nodes[cur].key;
+        if (key == k)
+            return root;
+        uint32_t next = key < k ? getLeft(p, cur) : getRight(p, cur);
+        if (next == NIL) {
+            uint32_t n = poolAlloc(p, key);
+            if (key < k)
+                setLeft(p, cur, n);
+            else
+                setRight(p, cur, n);
+            return root;
+        }
+        cur = next;
+    }
+}
+
+// ---------- shared: lookup and DFS-order rebuild ----------
+
+// Branch-free child selection: random lookups mispredict a compare-and-
+// jump at almost every level, a masked select only waits for the load.
+static inline int lookup(const struct CNode *nodes, uint32_t i, int key) {
+    while (i != NIL) {
+        const struct CNode *c = &nodes[i];
+        if (key == c->key)
+            return 1;
+        uint32_t l = c->left & IDX_MASK, r = c->right;
+        i = r ^ ((l ^ r) & -(uint32_t)(key < c->key));
+    }
+    return 0;
+}
+
+// In-order keys without recursion (explicit stack of indices)
+static uint32_t collectKeys(struct NodePool *p, uint32_t root, int *out) {
+    uint32_t stackBuf[128], *stack = stackBuf, cap = 128, top = 0, n = 0;
+    uint32_t cur = root;
+    while (cur != NIL || top > 0) {
+        while (cur != NIL) {
+            if (top == cap) {   // a degenerate BST can be arbitrarily deep
+                uint32_t *bigger = (uint32_t *)malloc(sizeof(uint32_t) * cap * 2);
+                for (uint32_t i = 0; i < top; i++)
+                    bigger[i] = stack[i];
+                if (stack != stackBuf)
+                    free(stack);
+                stack = bigger;
+                cap *= 2;
+            }
+            stack[top++] = cur;
+            cur = getLeft(p, cur);
+        }
+        cur = stack[--top];
+        out[n++] = p->nodes[cur].key;
+        cur = getRight(p, cur);
+    }
+    if (stack != stackBuf)
+        free(stack);
+    return n;
+}
+
+// Build keys[lo..hi] into slots taken in pre-order; returns the height
+static int buildDFS(struct NodePool *p, const int *keys, long lo, long hi, uint32_t *slot) {
+    if (lo > hi) {
+        *slot = NIL;
+        return 0;
+    }
+    long mid = lo + (hi - lo) / 2;
+    uint32_t n = p->used++;
+    uint32_t l, r;
+    p->nodes[n].key = keys[mid];
+    p->nodes[n].left = NIL;
+    int hl = buildDFS(p, keys, lo, mid - 1, &l);
+    int hr = buildDFS(p, keys, mid + 1, hi, &r);
+    setLeft(p, n, l);
+    setRight(p, n, r);
+    setBF(p, n, hr - hl);
+    *slot = n;
+    return (hl > hr ? hl : hr) + 1;
+}
+
+// Re-lay the tree out in a fresh, exactly sized pool in DFS order. The
+// result is perfectly balanced, so it is valid for both AVL and BST use.
+uint32_t rebuild(struct NodePool *p, uint32_t root) {
+    uint32_t count = p->used - 1;
+    int *keys = (int *)malloc(sizeof(int) * (count + 1));
+    uint32_t n = collectKeys(p, root, keys);
+    struct NodePool fresh;
+    uint32_t newRoot;
+    poolInit(&fresh, n + 1);
+    buildDFS(&fresh, keys, 0, (long)n - 1, &newRoot);
+    free(keys);
+    poolDestroy(p);
+    *p = fresh;
+    return newRoot;
+}
+
+// ---------- pointer-based reference (AVL-Tree_Operations.c) ----------
+
+struct Node {
+    int key;
+    struct Node *left;
+    struct Node *right;
+    int height;
+};
+
+int height(struct Node *N) { return N ? N->height : 0; }
+int max(int a, int b) { return (a > b) ? a : b; }
+
+struct Node *newNode(int key) {
+    struct Node *node = (struct Node *)malloc(sizeof(struct Node));
+    node->key = key;
+    node->left = node->right = NULL;
+    node->height = 1;
+    return node;
+}
+
+struct Node *rightRotate(struct Node *y) {
+    struct Node *x = y->left;
+    y->left = x->right;
+    x->right = y;
+    y->height = max(height(y->left), height(y->right)) + 1;
+    x->height = max(height(x->left), height(x->right)) + 1;
+    return x;
+}
+
+struct Node *leftRotate(struct Node *x) {
+    struct Node *y = x->right;
+    x->right = y->left;
+    y->left = x;
+    x->height = max(height(x->left), height(x->right)) + 1;
+    y->height = max(height(y->left), height(y->right)) + 1;
+    return y;
+}
+
+struct Node *insert(struct Node *node, int key) {
+    if (node == NULL)
+        return newNode(key);
+    if (key < node->key)
+        node->left = insert(node->left, key);
+    else if (key > node->key)
+        node->right = insert(node->right, key);
+    else
+        return node;
+    node->height = 1 + max(height(node->left), height(node->right));
+    int balance = height(node->left) - height(node->right);
+    if (balance > 1 && key < node->left->key)
+        return rightRotate(node);
+    if (balance < -1 && key > node->right->key)
+        return leftRotate(node);
+    if (balance > 1 && key > node->left->key) {
+        node->left = leftRotate(node->left);
+        return rightRotate(node);
+    }
+    if (balance < -1 && key < node->right->key) {
+        node->right = rightRotate(node->right);
+        return leftRotate(node);
+    }
+    return node;
+}
+
+int lookupPtr(struct Node *n, int key) {
+    while (n != NULL) {
+        if (key == n->key)
+            return 1;
+        n = key < n->key ? n->left : n->right;
+    }
+    return 0;
+}
+
+void freeTree(struct Node *root) {
+    if (root == NULL)
+        return;
+    freeTree(root->left);
+    freeTree(root->right);
+    free(root);
+}
+
+// ---------- checks and benchmark ----------
+
+// Verify order and balance codes; returns the height or -1
+static int checkAVL(struct NodePool *p, uint32_t n, long lo, long hi) {
+    if (n == NIL)
+        return 0;
+    int k = p->nodes[n].key;
+    if (k <= lo || k >= hi)
+        return -1;
+    int hl = checkAVL(p, getLeft(p, n), lo, k);
+    int hr = checkAVL(p, getRight(p, n), k, hi);
+    if (hl < 0 || hr < 0 || hr - hl != getBF(p, n))
+        return -1;
+    return (hl > hr ? hl : hr) + 1;
+}
+
+// In-order traversal
+void inorder(struct NodePool *p, uint32_t n) {
+    if (n != NIL) {
+        inorder(p, getLeft(p, n));
+        printf("%d ", p->nodes[n].key);
+        inorder(p, getRight(p, n));
+    }
+}
+
+static double nowSec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static unsigned int rng = 2463534242u;
+static int randomKey(void) {
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return (int)(rng & 0x7fffffff);
+}
+
+int main(int argc, char **argv) {
+    int n = argc > 1 ? atoi(argv[1]) : 4000000;
+    int q = argc > 2 ? atoi(argv[2]) : 4000000;
+    struct NodePool pool;
+    uint32_t root = NIL;
+    int grew, shrunk;
+
+    poolInit(&pool, 16);
+    printf("Inserting nodes...\n");
+    int demo[] = {10, 20, 30, 40, 50, 25};
+    for (int i = 0; i < 6; i++)
+        root = avlInsert(&pool, root, demo[i], &grew);
+    printf("Inorder traversal of the compact AVL tree:\n");
+    inorder(&pool, root);
+    root = avlDelete(&pool, root, 40, &shrunk);
+    printf("\nAfter deleting 40:\n");
+    inorder(&pool, root);
+    printf("\n");
+    poolDestroy(&pool);
+
+    // random insert/delete mix, checked for order and balance
+    poolInit(&pool, 16);
+    root = NIL;
+    int ok = 1;
+    srand(3);
+    for (int i = 0; i < 300000 && ok; i++) {
+        int key = rand() % 10000;
+        if (rand() % 3)
+            root = avlInsert(&pool, root, key, &grew);
+        else
+            root = avlDelete(&pool, root, key, &shrunk);
+        if (i % 5000 == 0)
+            ok = checkAVL(&pool, root, -1, 1L << 40) >= 0;
+    }
+    root = rebuild(&pool, root);
+    ok = ok && checkAVL(&pool, root, -1, 1L << 40) >= 0;
+    printf("Compact AVL check: %s\n", ok ? "OK" : "FAILED");
+    poolDestroy(&pool);
+
+    int *keys = (int *)malloc(sizeof(int) * n);
+    int *queries = (int *)malloc(sizeof(int) * q);
+    for (int i = 0; i < n; i++)
+        keys[i] = randomKey();
+    for (int i = 0; i < q; i++)
+        queries[i] = (i & 1) ? keys[randomKey() % n] : randomKey();
+
+    printf("\n%d keys, %d lookups\n", n, q);
+    printf("%-26s %14s %14s %10s\n", "layout", "bytes/node", "ns/lookup", "speedup");
+
+    struct Node *ptrRoot = NULL;
+    for (int i = 0; i < n; i++)
+        ptrRoot = insert(ptrRoot, keys[i]);
+    long hits = 0;
+    double t0 = nowSec();
+    for (int i = 0; i < q; i++)
+        hits += lookupPtr(ptrRoot, queries[i]);
+    double base = (nowSec() - t0) / q * 1e9;
+    // usable size plus the allocator's 8-byte chunk header
+    printf("%-26s %14zu %14.1f %10.2f\n", "pointer AVL (malloc)",
+           malloc_usable_size(ptrRoot) + 8, base, 1.0);
+    freeTree(ptrRoot);
+
+    const char *names[4] = {"index AVL (insert order)", "index AVL (DFS rebuild)",
+                            "index BST (insert order)", "index BST (DFS rebuild)"};
+    for (int kind = 0; kind < 2; kind++) {
+        poolInit(&pool, 1024);
+        root = NIL;
+        for (int i = 0; i < n; i++)
+            root = kind == 0 ? avlInsert(&pool, root, keys[i], &grew) : bstInsert(&pool, root, keys[i]);
+        for (int pass = 0; pass < 2; pass++) {
+            if (pass == 1)
+                root = rebuild(&pool, root);
+            long h = 0;
+            t0 = nowSec();
+            for (int i = 0; i < q; i++)
+                h += lookup(pool.nodes, root, queries[i]);
+            double t = (nowSec() - t0) / q * 1e9;
+            if (h != hits)
+                printf("lookup mismatch!\n");
+            printf("%-26s %14zu %14.1f %10.2f\n", names[kind * 2 + pass], sizeof(struct CNode), t, base / t);
+        }
+        poolDestroy(&pool);
+    }
+
+    free(keys);
+    free(queries);
+    return 0;
+}
@@ -0,0 +1,508 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+
+// Thread-safe B-tree using optimistic lock coupling (OLC).
+//
+// Every node carries a version word: bit 0 = obsolete, bit 1 = locked,
+// the remaining bits count modifications. Readers never write shared
+// memory: they remember the version of a node, read it, and re-check the
+// version before trusting what they read (restarting from the root if it
+// changed). Writers upgrade to an exclusive latch with a CAS on the
+// version, and only on the leaf they modify or on the nodes they split
+// (plus the parent that receives the separator).
+//
+// Keys live in the leaves (B+-tree layout) so readers never have to look
+// at values in inner nodes. Full inner nodes are split eagerly on the way
+// down, which guarantees the parent of a splitting leaf has room.
+// Nodes are never freed while threads run (insert/update only), so no
+// memory reclamation scheme is needed.
+//
+// Compile:
+//   gcc -O2 -pthread -o concurrent_btree Concurrent_B-Tree.c
+// Run:
+//   ./concurrent_btree [preload_keys] [ops_per_thread]
+
+#define MAX_KEYS 32   // Max keys in a node (leaf or inner)
+
+struct OLCNode {
+    _Atomic uint64_t version;
+    int isLeaf;
+    int count;
+    int key[MAX_KEYS];
+    union {
+        struct OLCNode *link[MAX_KEYS + 1];   // inner: count + 1 children
+        int value[MAX_KEYS];                  // leaf: one value per key
+    };
+};
+
+struct OLCTree {
+    _Atomic(struct OLCNode *) root;
+};
+
+// ---------- version / latch helpers ----------
+
+static int isLocked(uint64_t v) { return (v & 2) == 2; }
+static int isObsolete(uint64_t v) { return (v & 1) == 1; }
+
+static void cpuRelax(int *spins) {
+    if (++(*spins) > 64) {
+        sched_yield();   // oversubscribed: let the latch holder run
+        *spins = 0;
+    }
+}
+
+// Wait until the node is unlocked and return its version. Sets *restart
+// if the node became obsolete.
+static uint64_t readLockOrRestart(struct OLCNode *node, int *restart) {
+    int spins = 0;
+    uint64_t v = atomic_load_explicit(&node->version, memory_order_acquire);
+    while (isLocked(v)) {
+        cpuRelax(&spins);
+        v = atomic_load_explicit(&node->version, memory_order_acquire);
+    }
+    if (isObsolete(v))
+        *restart = 1;
+    return v;
+}
+
+// Validate that nothing changed since version v was read.
+static void readUnlockOrRestart(struct OLCNode *node, uint64_t v, int *restart) {
+    atomic_thread_fence(memory_order_acquire);
+    if (atomic_load_explicit(&node->version, memory_order_relaxed) != v)
+        *restart = 1;
+}
+
+static void upgradeToWriteLockOrRestart(struct OLCNode *node, uint64_t v, int *restart) {
+    if (!atomic_compare_exchange_strong(&node->version, &v, v + 2))
+        *restart = 1;
+}
+
+static void writeUnlock(struct OLCNode *node) {
+    // clears the lock bit and bumps the counter in one step
+    atomic_fetch_add_explicit(&node->version, 2, memory_order_release);
+}
+
+// ---------- node helpers ----------
+
+static struct OLCNode *createNode(int isLeaf) {
+    struct OLCNode *node = (struct OLCNode *)calloc(1, sizeof(struct OLCNode));
+    atomic_init(&node->version, 4);
+    node->isLeaf = isLeaf;
+    return node;
+}
+
+// First position whose key is >= val. The count may be torn while a
+// writer is active, so it is clamped; the caller validates afterwards.
+static int lowerBound(struct OLCNode *node, int val) {
+    int lo = 0, hi = node->count;
+    if (hi > MAX_KEYS) hi = MAX_KEYS;
+    if (hi < 0) hi = 0;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if (node->key[mid] < val)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
+// Child slot to follow in an inner node: keys equal to a separator go right.
+static int childIndex(struct OLCNode *node, int val) {
+    int pos = lowerBound(node, val);
+    if (pos < node->count && pos < MAX_KEYS && node->key[pos] == val)
+        pos++;
+    return pos;
+}
+
+static void insertIntoLeaf(struct OLCNode *leaf, int val, int value) {
+    int pos = lowerBound(leaf, val);
+    if (pos < leaf->count && leaf->key[pos] == val) {
+        leaf->value[pos] = value;
+        return;
+    }
+    for (int j = leaf->count; j > pos; j--) {
+        leaf->key[j] = leaf->key[j - 1];
+        leaf->value[j] = leaf->value[j - 1];
+    }
+    leaf->key[pos] = val;
+    leaf->value[pos] = value;
+    leaf->count++;
+}
+
+static void insertIntoInner(struct OLCNode *inner, int sep, struct OLCNode *child) {
+    int pos = lowerBound(inner, sep);
+    for (int j = inner->count; j > pos; j--) {
+        inner->key[j] = inner->key[j - 1];
+        inner->link[j + 1] = inner->link[j];
+    }
+    inner->key[pos] = sep;
+    inner->link[pos + 1] = child;
+    inner->count++;
+}
+
+// Split a full node. Returns the new right sibling and the separator.
+static struct OLCNode *splitNode(struct OLCNode *node, int *sep) {
+    struct OLCNode *right = createNode(node->isLeaf);
+    int half = node->count / 2;
+    if (node->isLeaf) {
+        right->count = node->count - half;
+        for (int j = 0; j < right->count; j++) {
+            right->key[j] = node->key[half + j];
+            right->value[j] = node->value[half + j];
+        }
+        node->count = half;
+        *sep = right->key[0];
+    } else {
+        // key[half] moves up, it is not kept in either half
+        *sep = node->key[half];
+        right->count = node->count - half - 1;
+        for (int j = 0; j < right->count; j++)
+            right->key[j] = node->key[half + 1 + j];
+        for (int j = 0; j <= right->count; j++)
+            right->link[j] = node->link[half + 1 + j];
+        node->count = half;
+    }
+    return right;
+}
+
+static void makeRoot(struct OLCTree *tree, int sep, struct OLCNode *left, struct OLCNode *right) {
+    struct OLCNode *newRoot = createNode(0);
+    newRoot->count = 1;
+    newRoot->key[0] = sep;
+    newRoot->link[0] = left;
+    newRoot->link[1] = right;
+    atomic_store_explicit(&tree->root, newRoot, memory_order_release);
+}
+
+// ---------- operations ----------
+
+void initTree(struct OLCTree *tree) {
+    atomic_init(&tree->root, createNode(1));
+}
+
+// Lookup: returns 1 and stores the value if the key is present.
+int lookup(struct OLCTree *tree, int val, int *out) {
+    for (;;) {
+        int restart = 0;
+        struct OLCNode *node = atomic_load_explicit(&tree->root, memory_order_acquire);
+        uint64_t v = readLockOrRestart(node, &restart);
+        if (restart || node != atomic_load(&tree->root))
+            continue;
+
+        struct OLCNode *parent = NULL;
+        uint64_t vParent = 0;
+        while (!node->isLeaf) {
+            struct OLCNode *inner = node;
+            if (parent) {
+                readUnlockOrRestart(parent, vParent, &restart);
+                if (restart) break;
+            }
+            parent = inner;
+            vParent = v;
+
+            node = inner->link[childIndex(inner, val)];
+            // the child pointer is only trustworthy if inner did not change
+            readUnlockOrRestart(inner, v, &restart);
+            if (restart) break;
+            v = readLockOrRestart(node, &restart);
+            if (restart) break;
+        }
+        if (restart)
+            continue;
+
+        int pos = lowerBound(node, val);
+        int found = pos < node->count && pos < MAX_KEYS && node->key[pos] == val;
+        int value = found ? node->value[pos] : 0;
+
+        if (parent) {
+            readUnlockOrRestart(parent, vParent, &restart);
+            if (restart) continue;
+        }
+        readUnlockOrRestart(node, v, &restart);
+        if (restart)
+            continue;
+        if (found && out)
+            *out = value;
+        return found;
+    }
+}
+
+// Insert or update a key.
+void insert(struct OLCTree *tree, int val, int value) {
+    for (;;) {
+        int restart = 0;
+        struct OLCNode *node = atomic_load_explicit(&tree->root, memory_order_acquire);
+        uint64_t v = readLockOrRestart(node, &restart);
+        if (restart || node != atomic_load(&tree->root))
+            continue;
+
+        struct OLCNode *parent = NULL;
+        uint64_t vParent = 0;
+
+        while (!node->isLeaf) {
+            struct OLCNode *inner = node;
+
+            // Split full inner nodes eagerly so a split below always fits.
+            if (inner->count == MAX_KEYS) {
+                if (parent) {
+                    upgradeToWriteLockOrRestart(parent, vParent, &restart);
+                    if (restart) break;
+                }
+                upgradeToWriteLockOrRestart(inner, v, &restart);
+                if (restart) {
+                    if (parent) writeUnlock(parent);
+                    break;
+                }
+                if (!parent && inner != atomic_load(&tree->root)) {
+                    writeUnlock(inner);
+                    restart = 1;
+                    break;
+                }
+                int sep;
+                struct OLCNode *right = splitNode(inner, &sep);
+                if (parent)
+                    insertIntoInner(parent, sep, right);
+                else
+                    makeRoot(tree, sep, inner, right);
+                writeUnlock(inner);
+                if (parent) writeUnlock(parent);
+                restart = 1;
+                break;
+            }
+
+            if (parent) {
+                readUnlockOrRestart(parent, vParent, &restart);
+                if (restart) break;
+            }
+            parent = inner;
+            vParent = v;
+
+            node = inner->link[childIndex(inner, val)];
+            readUnlockOrRestart(inner, v, &restart);
+            if (restart) break;
+            v = readLockOrRestart(node, &restart);
+            if (restart) break;
+        }
+        if (restart)
+            continue;
+
+        struct OLCNode *leaf = node;
+        if (leaf->count == MAX_KEYS) {
+            // Leaf split: latch parent and leaf only for the split itself.
+            if (parent) {
+                upgradeToWriteLockOrRestart(parent, vParent, &restart);
+                if (restart) continue;
+            }
+            upgradeToWriteLockOrRestart(leaf, v, &restart);
+            if (restart) {
+                if (parent) writeUnlock(parent);
+                continue;
+            }
+            if (!parent && leaf != atomic_load(&tree->root)) {
+                writeUnlock(leaf);
+                continue;
+            }
+            int sep;
+            struct OLCNode *right = splitNode(leaf, &sep);
+            if (parent)
+                insertIntoInner(parent, sep, right);
+            else
+                makeRoot(tree, sep, leaf, right);
+            writeUnlock(leaf);
+            if (parent) writeUnlock(parent);
+            continue;   // retry the insert against the split leaves
+        }
+
+        upgradeToWriteLockOrRestart(leaf, v, &restart);
+        if (restart)
+            continue;
+        if (parent) {
+            readUnlockOrRestart(parent, vParent, &restart);
+            if (restart) {
+                writeUnlock(leaf);
+                continue;
+            }
+        }
+        insertIntoLeaf(leaf, val, value);
+        writeUnlock(leaf);
+        return;
+    }
+}
+
+// Display keys in order (single-threaded use only)
+void display(struct OLCNode *node) {
+    if (node->isLeaf) {
+        for (int i = 0; i < node->count; i++)
+            printf("%d ", node->key[i]);
+        return;
+    }
+    for (int i = 0; i <= node->count; i++)
+        display(node->link[i]);
+}
+
+// Check ordering and count keys (single-threaded use only)
+static long checkTree(struct OLCNode *node, long *prev, int *ok) {
+    long total = 0;
+    if (node->isLeaf) {
+        for (int i = 0; i < node->count; i++) {
+            if (node->key[i] <= *prev) *ok = 0;
+            *prev = node->key[i];
+        }
+        return node->count;
+    }
+    for (int i = 0; i <= node->count; i++)
+        total += checkTree(node->link[i], prev, ok);
+    return total;
+}
+
+void freeTree(struct OLCNode *node) {
+    if (!node->isLeaf)
+        for (int i = 0; i <= node->count; i++)
+            freeTree(node->link[i]);
+    free(node);
+}
+
+// ---------- benchmark ----------
+
+static struct OLCTree tree;
+static int keySpace;
+static long opsPerThread;
+static int readPercent;
+static _Atomic int startFlag;
+
+struct Worker {
+    pthread_t tid;
+    int id;
+    int nthreads;
+    uint64_t seed;
+    long hits;
+};
+
+static uint64_t xorshift(uint64_t *s) {
+    uint64_t x = *s;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    return *s = x;
+}
+
+static double nowSec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void *mixWorker(void *arg) {
+    struct Worker *w = (struct Worker *)arg;
+    while (!atomic_load(&startFlag))
+        sched_yield();
+    for (long i = 0; i < opsPerThread; i++) {
+        uint64_t r = xorshift(&w->seed);
+        int key = (int)(r % (uint64_t)keySpace);
+        int value;
+        if ((int)((r >> 40) % 100) < readPercent)
+            w->hits += lookup(&tree, key, &value);
+        else
+            insert(&tree, key, (int)i);
+    }
+    return NULL;
+}
+
+static void *fillWorker(void *arg) {
+    struct Worker *w = (struct Worker *)arg;
+    // disjoint interleaved keys: every key is inserted by exactly one thread
+    for (int k = w->id; k < keySpace; k += w->nthreads)
+        insert(&tree, k * 2, k);
+    return NULL;
+}
+
+// Concurrent inserts of disjoint keys, then verify every key is present.
+static int verifyConcurrentInserts(int nthreads, int n) {
+    struct Worker w[64];
+    keySpace = n;
+    initTree(&tree);
+    for (int t = 0; t < nthreads; t++) {
+        w[t].id = t;
+        w[t].nthreads = nthreads;
+        pthread_create(&w[t].tid, NULL, fillWorker, &w[t]);
+    }
+    for (int t = 0; t < nthreads; t++)
+        pthread_join(w[t].tid, NULL);
+
+    int ok = 1;
+    long prev = -1;
+    long total = checkTree(atomic_load(&tree.root), &prev, &ok);
+    for (int k = 0; k < n && ok; k++) {
+        int value;
+        if (!lookup(&tree, k * 2, &value) || value != k) ok = 0;
+        if (lookup(&tree, k * 2 + 1, &value)) ok = 0;
+    }
+    freeTree(atomic_load(&tree.root));
+    return ok && total == n;
+}
+
+static double runMix(int nthreads, int preload) {
+    struct Worker w[64];
+    initTree(&tree);
+    for (int k = 0; k < preload; k++)
+        insert(&tree, k * 2, k);   // even keys present, odd keys are misses / new inserts
+    keySpace = preload * 2;
+
+    atomic_store(&startFlag, 0);
+    for (int t = 0; t < nthreads; t++) {
+        w[t].id = t;
+        w[t].nthreads = nthreads;
+        w[t].seed = 0x9E3779B97F4A7C15ULL * (t + 1);
+        w[t].hits = 0;
+        pthread_create(&w[t].tid, NULL, mixWorker, &w[t]);
+    }
+    double t0 = nowSec();
+    atomic_store(&startFlag, 1);
+    for (int t = 0; t < nthreads; t++)
+        pthread_join(w[t].tid, NULL);
+    double elapsed = nowSec() - t0;
+
+    freeTree(atomic_load(&tree.root));
+    return (double)opsPerThread * nthreads / elapsed / 1e6;
+}
+
+int main(int argc, char **argv) {
+    int i;
+    int values[] = {10, 20, 5, 6, 12, 30, 7, 17};
+    int preload = argc > 1 ? atoi(argv[1]) : 1000000;
+    opsPerThread = argc > 2 ? atol(argv[2]) : 1000000;
+
+    initTree(&tree);
+    printf("Inserting values into concurrent B-Tree:\n");
+    for (i = 0; i < 8; i++)
+        insert(&tree, values[i], i);
+    printf("B-Tree after insertion:\n");
+    display(atomic_load(&tree.root));
+    printf("\n");
+    freeTree(atomic_load(&tree.root));
+
+    printf("Concurrent insert check (8 threads, 200000 keys): %s\n",
+           verifyConcurrentInserts(8, 200000) ? "OK" : "FAILED");
+
+    int threadCounts[] = {1, 2, 4, 8, 16, 32, 64};
+    int mixes[] = {95, 50};
+    for (int m = 0; m < 2; m++) {
+        readPercent = mixes[m];
+        printf("\n%d%% lookups / %d%% inserts, %d preloaded keys, %ld ops per thread\n",
+               readPercent, 100 - readPercent, preload, opsPerThread);
+        printf("%8s %12s %10s\n", "threads", "Mops/s", "speedup");
+        double base = 0;
+        for (i = 0; i < 7; i++) {
+            double mops = runMix(threadCounts[i], preload);
+            if (i == 0) base = mops;
+            printf("%8d %12.2f %10.2f\n", threadCounts[i], mops, mops / base);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,118 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+// Demo of ordered_map.h: the same operations on all four trees.
+//
+// The maps use 64-bit keys with a 64-bit payload. main() first prints a
+// small example through the callback scan, then applies one long random
+// sequence of insert/erase/find/lower_bound/scan operations to every map
+// and checks that all four give identical answers.
+//
+// Compile:
+//   gcc -O2 -o ordered_map_demo Ordered_Map_Demo.c
+// Run:
+//   ./ordered_map_demo [operations]
+
+#define OM_KEY_T uint64_t
+#define OM_VAL_T uint64_t
+#include "ordered_map.h"
+
+static int printEntry(uint64_t key, uint64_t *val, void *ctx) {
+    (void)ctx;
+    printf("%llu=%llu ", (unsigned long long)key, (unsigned long long)*val);
+    return 0;
+}
+
+// Folds the visited entries into a checksum
+static int hashEntry(uint64_t key, uint64_t *val, void *ctx) {
+    uint64_t *h = (uint64_t *)ctx;
+    *h = (*h ^ key) * 0x100000001b3ULL + *val;
+    return 0;
+}
+
+static uint64_t rngState = 0x9E3779B97F4A7C15ULL;
+
+static uint64_t rngNext(void) {
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 7;
+    rngState ^= rngState << 17;
+    return rngState;
+}
+
+int main(int argc, char **argv) {
+    int ops = argc > 1 ? atoi(argv[1]) : 1000000;
+    struct BstMap bst;
+    struct AvlMap avl;
+    struct SplayMap splay;
+    struct BTreeMap btree;
+    bstMapInit(&bst);
+    avlMapInit(&avl);
+    splayMapInit(&splay);
+    btreeMapInit(&btree);
+
+    uint64_t keys[] = {10, 20, 5, 6, 12, 30, 7, 17};
+    for (int i = 0; i < 8; i++)
+        btreeMapInsert(&btree, keys[i], keys[i] * 100);
+    btreeMapErase(&btree, 6);
+    printf("B-tree map after deleting 6: ");
+    btreeMapScan(&btree, 0, SIZE_MAX, printEntry, NULL);
+    uint64_t k = 0;
+    btreeMapLowerBound(&btree, 13, &k, NULL);
+    printf("\nlower_bound(13) = %llu\n", (unsigned long long)k);
+    btreeMapFree(&btree);
+
+    // identical random workload on all four maps
+    int mismatches = 0;
+    uint64_t range = 50000;
+    for (int i = 0; i < ops; i++) {
+        uint64_t key = rngNext() % range, r = rngNext() % 100;
+        if (r < 40) {
+            uint64_t val = rngNext();
+            int a = bstMapInsert(&bst, key, val), b = avlMapInsert(&avl, key, val);
+            int c = splayMapInsert(&splay, key, val), d = btreeMapInsert(&btree, key, val);
+            mismatches += !(a == b && b == c && c == d);
+        } else if (r < 70) {
+            int a = bstMapErase(&bst, key), b = avlMapErase(&avl, key);
+            int c = splayMapErase(&splay, key), d = btreeMapErase(&btree, key);
+            mismatches += !(a == b && b == c && c == d);
+        } else if (r < 90) {
+            uint64_t *a = bstMapFind(&bst, key), *b = avlMapFind(&avl, key);
+            uint64_t *c = splayMapFind(&splay, key), *d = btreeMapFind(&btree, key);
+            if (a == NULL)
+                mismatches += b || c || d;
+            else
+                mismatches += !(b && c && d && *a == *b && *b == *c && *c == *d);
+        } else if (r < 97) {
+            uint64_t ka = 0, kb = 0, kc = 0, kd = 0, va = 0, vb = 0, vc = 0, vd = 0;
+            int a = bstMapLowerBound(&bst, key, &ka, &va), b = avlMapLowerBound(&avl, key, &kb, &vb);
+            int c = splayMapLowerBound(&splay, key, &kc, &vc), d = btreeMapLowerBound(&btree, key, &kd, &vd);
+            mismatches += !(a == b && b == c && c == d && ka == kb && kb == kc && kc == kd &&
+                            va == vb && vb == vc && vc == vd);
+        } else {
+            uint64_t h[4] = {0, 0, 0, 0};
+            size_t a = bstMapScan(&bst, key, 100, hashEntry, &h[0]);
+            size_t b = avlMapScan(&avl, key, 100, hashEntry, &h[1]);
+            size_t c = splayMapScan(&splay, key, 100, hashEntry, &h[2]);
+            size_t d = btreeMapScan(&btree, key, 100, hashEntry, &h[3]);
+            mismatches += !(a == b && b == c && c == d && h[0] == h[1] && h[1] == h[2] && h[2] == h[3]);
+        }
+    }
+
+    uint64_t h[4] = {0, 0, 0, 0};
+    size_t a = bstMapScan(&bst, 0, SIZE_MAX, hashEntry, &h[0]);
+    size_t b = avlMapScan(&avl, 0, SIZE_MAX, hashEntry, &h[1]);
+    size_t c = splayMapScan(&splay, 0, SIZE_MAX, hashEntry, &h[2]);
+    size_t d = btreeMapScan(&btree, 0, SIZE_MAX, hashEntry, &h[3]);
+    mismatches += !(a == b && b == c && c == d && a == bst.size && d == btree.size &&
+                    h[0] == h[1] && h[1] == h[2] && h[2] == h[3]);
+
+    printf("%d random operations, %zu keys left, B-tree height %d\n", ops, bst.size, btree.height);
+    printf("BST, AVL, splay and B-tree maps agree: %s\n", mismatches ? "FAILED" : "OK");
+
+    bstMapFree(&bst);
+    avlMapFree(&avl);
+    splayMapFree(&splay);
+    btreeMapFree(&btree);
+    return mismatches != 0;
+}
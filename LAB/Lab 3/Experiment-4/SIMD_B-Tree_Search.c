@@ -0,0 +1,308 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#include <x86intrin.h>
+#define HAVE_X86 1
+#endif
+
+// B-Tree with wide nodes and SIMD in-node key search.
+//
+// Keys of a node are kept in one contiguous, 32-byte aligned array that is
+// padded with INT_MAX up to the next multiple of 8. The slot to follow is
+// the number of keys smaller than the search key, which AVX2 computes with
+// compare + movemask + popcount over the whole node, without branches.
+// The scalar fallback is the backwards linear scan used by setValue() in
+// B-Tree_Operations.c. The node width (max keys per node) is chosen at
+// run time so one binary can compare 16, 32 and 64 key nodes.
+// The benchmark reports two costs per width: a whole lookup (descent
+// including cache misses on child loads) and the in-node search alone,
+// timed by repeating it over a few nodes that stay in L1.
+//
+// Compile:
+//   gcc -O2 -o simd_btree SIMD_B-Tree_Search.c
+// Run:
+//   ./simd_btree [keys] [lookups]
+
+#define MAXW 64          // Largest supported node width
+#define PAD (MAXW + 8)   // room for one overflow key before a split + padding
+
+struct BTreeNode {
+    int val[PAD] __attribute__((aligned(32)));
+    int count;
+    struct BTreeNode *link[MAXW + 2];
+};
+
+static int width = 16;   // Max keys in a node for the current tree
+
+// Returns the number of keys in node that are smaller than val
+typedef int (*SearchFn)(const struct BTreeNode *node, int val);
+
+// Scalar: same backwards scan as setValue(), on 0-based keys
+static int searchScalar(const struct BTreeNode *node, int val) {
+    int pos;
+    for (pos = node->count; pos > 0 && val <= node->val[pos - 1]; pos--);
+    return pos;
+}
+
+#ifdef HAVE_X86
+// AVX2: padded slots hold INT_MAX, so they never compare smaller than val
+__attribute__((target("avx2,popcnt")))
+static int searchAVX2(const struct BTreeNode *node, int val) {
+    __m256i k = _mm256_set1_epi32(val);
+    int pos = 0;
+    for (int i = 0; i < width; i += 8) {
+        __m256i v = _mm256_load_si256((const __m256i *)&node->val[i]);
+        __m256i lt = _mm256_cmpgt_epi32(k, v);
+        pos += __builtin_popcount((unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(lt)));
+    }
+    return pos;
+}
+#endif
+
+static SearchFn nodeSearch = searchScalar;
+
+// Pick AVX2 when the CPU has it, otherwise keep the scalar scan
+static void chooseSearch(void) {
+#ifdef HAVE_X86
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt"))
+        nodeSearch = searchAVX2;
+#endif
+}
+
+// Create a new empty node with all key slots padded
+static struct BTreeNode *createNode(void) {
+    struct BTreeNode *node = (struct BTreeNode *)aligned_alloc(32, sizeof(struct BTreeNode));
+    for (int i = 0; i < PAD; i++)
+        node->val[i] = INT_MAX;
+    node->count = 0;
+    memset(node->link, 0, sizeof(node->link));
+    return node;
+}
+
+// Insert val and child at pos (node may temporarily hold width + 1 keys)
+static void addValToNode(struct BTreeNode *node, int pos, int val, struct BTreeNode *child) {
+    for (int j = node->count; j > pos; j--) {
+        node->val[j] = node->val[j - 1];
+        node->link[j + 1] = node->link[j];
+    }
+    node->val[pos] = val;
+    node->link[pos + 1] = child;
+    node->count++;
+}
+
+// Split an overflowing node; the median moves up through *pval
+static struct BTreeNode *splitNode(struct BTreeNode *node, int *pval) {
+    struct BTreeNode *right = createNode();
+    int median = node->count / 2;
+    *pval = node->val[median];
+    right->count = node->count - median - 1;
+    for (int j = 0; j < right->count; j++)
+        right->val[j] = node->val[median + 1 + j];
+    for (int j = 0; j <= right->count; j++)
+        right->link[j] = node->link[median + 1 + j];
+    for (int j = median; j < PAD; j++)
+        node->val[j] = INT_MAX;
+    node->count = median;
+    return right;
+}
+
+// Insert val below node. Returns 1 with (*pval, *child) if node split.
+static int setValue(int val, int *pval, struct BTreeNode *node, struct BTreeNode **child) {
+    int pos = nodeSearch(node, val);
+    if (pos < node->count && node->val[pos] == val)
+        return 0;   // duplicates are ignored
+
+    if (node->link[0] == NULL) {
+        addValToNode(node, pos, val, NULL);
+    } else {
+        int up;
+        struct BTreeNode *newChild;
+        if (!setValue(val, &up, node->link[pos], &newChild))
+            return 0;
+        addValToNode(node, pos, up, newChild);
+    }
+    if (node->count <= width)
+        return 0;
+    *child = splitNode(node, pval);
+    return 1;
+}
+
+static struct BTreeNode *insert(struct BTreeNode *root, int val) {
+    int up;
+    struct BTreeNode *child;
+    if (root == NULL)
+        root = createNode();
+    if (setValue(val, &up, root, &child)) {
+        struct BTreeNode *newRoot = createNode();
+        newRoot->val[0] = up;
+        newRoot->count = 1;
+        newRoot->link[0] = root;
+        newRoot->link[1] = child;
+        root = newRoot;
+    }
+    return root;
+}
+
+// Search with the given in-node search; counts the nodes visited
+static int lookup(struct BTreeNode *node, int val, SearchFn search, long *visited) {
+    while (node != NULL) {
+        int pos = search(node, val);
+        (*visited)++;
+        if (pos < node->count && node->val[pos] == val)
+            return 1;
+        node = node->link[pos];
+    }
+    return 0;
+}
+
+static void freeTree(struct BTreeNode *node) {
+    if (node == NULL)
+        return;
+    for (int i = 0; i <= node->count; i++)
+        freeTree(node->link[i]);
+    free(node);
+}
+
+// Display B-Tree in order
+static void display(struct BTreeNode *node) {
+    int i;
+    if (node != NULL) {
+        for (i = 0; i < node->count; i++) {
+            display(node->link[i]);
+            printf("%d ", node->val[i]);
+        }
+        display(node->link[i]);
+    }
+}
+
+static unsigned long long cycles(void) {
+#ifdef HAVE_X86
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+static unsigned int rng = 2463534242u;
+static int randomKey(void) {
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return (int)(rng & 0x3fffffff);
+}
+
+// Time lookups with one search function; returns cycles per lookup
+static double timeLookups(struct BTreeNode *root, const int *queries, int q, SearchFn search,
+                          long *visited, int *hits) {
+    *visited = 0;
+    *hits = 0;
+    unsigned long long t0 = cycles();
+    for (int i = 0; i < q; i++)
+        *hits += lookup(root, queries[i], search, visited);
+    return (double)(cycles() - t0) / q;
+}
+
+#define HOT_NODES 16     // nodes searched repeatedly; their keys stay in L1
+#define HOT_ROUNDS 4096
+
+// Collect up to HOT_NODES distinct nodes from the top levels, breadth first
+static int hotNodes(struct BTreeNode *root, struct BTreeNode **hot) {
+    int n = root != NULL, head = 0;
+    hot[0] = root;
+    while (head < n && n < HOT_NODES) {
+        struct BTreeNode *p = hot[head++];
+        for (int i = 0; i <= p->count && p->link[0] != NULL && n < HOT_NODES; i++)
+            hot[n++] = p->link[i];
+    }
+    return n;
+}
+
+// Time the in-node search alone: the same few nodes are searched over and
+// over, so no child pointer is followed and no cache miss is measured.
+// Returns cycles per search call.
+static double timeInNode(struct BTreeNode **hot, int nh, const int *queries, int q,
+                         SearchFn search, long *sum) {
+    int nq = q < 1024 ? q : 1024;
+    *sum = 0;
+    for (int i = 0; i < nh; i++)   // warm up
+        *sum += search(hot[i], queries[0]);
+    *sum = 0;
+    unsigned long long t0 = cycles();
+    for (int r = 0; r < HOT_ROUNDS; r++) {
+        int val = queries[r % nq];
+        for (int i = 0; i < nh; i++)
+            *sum += search(hot[i], val);
+    }
+    return (double)(cycles() - t0) / ((double)HOT_ROUNDS * nh);
+}
+
+int main(int argc, char **argv) {
+    int n = argc > 1 ? atoi(argv[1]) : 1000000;
+    int q = argc > 2 ? atoi(argv[2]) : 2000000;
+    int values[] = {10, 20, 5, 6, 12, 30, 7, 17};
+    struct BTreeNode *root = NULL;
+
+    chooseSearch();
+    printf("In-node search: %s\n", nodeSearch == searchScalar ? "scalar" : "AVX2");
+
+    printf("Inserting values into B-Tree:\n");
+    for (int i = 0; i < 8; i++)
+        root = insert(root, values[i]);
+    display(root);
+    printf("\n");
+    freeTree(root);
+
+    int *keys = (int *)malloc(sizeof(int) * n);
+    int *queries = (int *)malloc(sizeof(int) * q);
+    for (int i = 0; i < n; i++)
+        keys[i] = randomKey();
+    for (int i = 0; i < q; i++)
+        queries[i] = (i & 1) ? keys[randomKey() % n] : randomKey();   // half hits, half random
+
+    int widths[] = {16, 32, 64};
+    printf("\n%d keys, %d lookups (cycles via rdtsc)\n", n, q);
+    printf("%6s %8s %14s %14s %14s %14s %8s %8s\n", "width", "height", "scalar/lookup",
+           "scalar/search", "simd/lookup", "simd/search", "lookup x", "search x");
+    for (int w = 0; w < 3; w++) {
+        width = widths[w];
+        root = NULL;
+        for (int i = 0; i < n; i++)
+            root = insert(root, keys[i]);
+
+        int height = 0;
+        for (struct BTreeNode *p = root; p; p = p->link[0])
+            height++;
+
+        long visitedScalar, visitedSimd;
+        int hitsScalar, hitsSimd;
+        double scalar = timeLookups(root, queries, q, searchScalar, &visitedScalar, &hitsScalar);
+        double simd = scalar;
+        visitedSimd = visitedScalar;
+        hitsSimd = hitsScalar;
+        if (nodeSearch != searchScalar)
+            simd = timeLookups(root, queries, q, nodeSearch, &visitedSimd, &hitsSimd);
+
+        // in-node search on L1-resident nodes, without the descent
+        struct BTreeNode *hot[HOT_NODES];
+        int nh = hotNodes(root, hot);
+        long sumScalar, sumSimd;
+        double searchS = timeInNode(hot, nh, queries, q, searchScalar, &sumScalar);
+        double searchV = searchS;
+        sumSimd = sumScalar;
+        if (nodeSearch != searchScalar)
+            searchV = timeInNode(hot, nh, queries, q, nodeSearch, &sumSimd);
+        if (hitsScalar != hitsSimd || visitedScalar != visitedSimd || sumScalar != sumSimd)
+            printf("Mismatch between scalar and SIMD search!\n");
+
+        printf("%6d %8d %14.1f %14.1f %14.1f %14.1f %8.2f %8.2f\n", width, height,
+               scalar, searchS, simd, searchV, scalar / simd, searchS / searchV);
+        freeTree(root);
+    }
+
+    free(keys);
+    free(queries);
+    return 0;
+}
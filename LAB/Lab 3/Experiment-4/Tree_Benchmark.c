@@ -0,0 +1,318 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <malloc.h>
+
+// YCSB-style benchmark of the four ordered_map.h trees.
+//
+// Each run loads `keys` records into a fresh map and then executes
+// `ops` operations of one workload:
+//
+//   A  update heavy   50% read, 50% update
+//   B  read mostly    95% read,  5% update
+//   C  read only     100% read
+//   E  short scans    95% scan of 1..100 entries, 5% insert of a new key
+//   I  insert only    the load itself, keys in random order
+//   S  sequential     the load itself, keys in ascending order
+//
+// Reads, updates and scan starts pick a record uniformly or from a
+// scrambled zipfian distribution (theta 0.99, as in YCSB). Record i has
+// key mix64(i), so keys are unique, spread out and need no key array;
+// the S workload uses key i instead.
+//
+// Reported per tree: throughput, p50/p99/p999 latency from a log-scale
+// histogram (one op in LAT_SAMPLE is timed, which keeps the clock reads
+// out of the throughput), bytes of heap per key as seen by a counting
+// allocator hooked into ordered_map.h, and tree height.
+//
+// With -DOM_STATS each row is followed by the JSON counter dump of
+// ordered_map.h (rotations, splits, comparisons, depth histogram).
+//
+// Compile:
+//   gcc -O2 -o tree_benchmark Tree_Benchmark.c -lm
+//   gcc -O2 -DOM_STATS -o tree_benchmark_stats Tree_Benchmark.c -lm
+// Run:
+//   ./tree_benchmark [keys] [ops] [workloads] [uniform|zipfian|both] [trees]
+//   e.g. ./tree_benchmark 10000000 10000000 ABCE zipfian avl,btree
+
+static size_t liveBytes;
+
+static void *countedMalloc(size_t size) {
+    void *p = malloc(size);
+    liveBytes += malloc_usable_size(p);
+    return p;
+}
+
+static void countedFree(void *p) {
+    liveBytes -= malloc_usable_size(p);
+    free(p);
+}
+
+#define OM_KEY_T uint64_t
+#define OM_VAL_T uint64_t
+#define OM_MALLOC(size) countedMalloc(size)
+#define OM_FREE(p) countedFree(p)
+#include "ordered_map.h"
+
+#define LAT_SAMPLE 8
+#define BST_SEQUENTIAL_LIMIT 50000   // a sorted load makes the BST a list: O(n^2)
+
+// ---------- random numbers and key distributions ----------
+
+static uint64_t rngState = 0x2545F4914F6CDD1DULL;
+
+static inline uint64_t rngNext(void) {
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 7;
+    rngState ^= rngState << 17;
+    return rngState;
+}
+
+static inline double rngUniform(void) {
+    return (rngNext() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+// Bijective 64-bit mixer (splitmix64 finalizer)
+static inline uint64_t mix64(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xBF58476D1CE4E5B9ULL;
+    x ^= x >> 27;
+    x *= 0x94D049BB133111EBULL;
+    x ^= x >> 31;
+    return x;
+}
+
+// Zipfian over [0, n) by Gray et al.'s method, O(1) per draw
+struct Zipf {
+    uint64_t n;
+    double theta, alpha, zetan, eta;
+};
+
+static void zipfInit(struct Zipf *z, uint64_t n, double theta) {
+    double zeta2 = 1.0 + pow(0.5, theta);
+    z->n = n;
+    z->theta = theta;
+    z->zetan = 0;
+    for (uint64_t i = 1; i <= n; i++)
+        z->zetan += 1.0 / pow((double)i, theta);
+    z->alpha = 1.0 / (1.0 - theta);
+    z->eta = (1.0 - pow(2.0 / n, 1.0 - theta)) / (1.0 - zeta2 / z->zetan);
+}
+
+static inline uint64_t zipfNext(const struct Zipf *z) {
+    double u = rngUniform(), uz = u * z->zetan;
+    if (uz < 1.0) return 0;
+    if (uz < 1.0 + pow(0.5, z->theta)) return 1;
+    uint64_t r = (uint64_t)(z->n * pow(z->eta * u - z->eta + 1.0, z->alpha));
+    return r < z->n ? r : z->n - 1;
+}
+
+// ---------- latency histogram: 8 sub-buckets per power of two ----------
+
+#define HIST_BUCKETS (16 + 60 * 8)
+
+struct Histogram {
+    uint64_t count[HIST_BUCKETS];
+    uint64_t total;
+};
+
+static inline int histBucket(uint64_t ns) {
+    if (ns < 16)
+        return (int)ns;
+    int e = 63 - __builtin_clzll(ns);
+    return 16 + (e - 4) * 8 + (int)((ns >> (e - 3)) & 7);
+}
+
+static uint64_t histLowerBound(int b) {
+    if (b < 16)
+        return b;
+    int e = (b - 16) / 8 + 4;
+    return (8ULL + (b - 16) % 8) << (e - 3);
+}
+
+static uint64_t histPercentile(const struct Histogram *h, double p) {
+    uint64_t target = (uint64_t)ceil(p * h->total), seen = 0;
+    for (int b = 0; b < HIST_BUCKETS; b++) {
+        seen += h->count[b];
+        if (seen >= target && seen > 0)
+            return histLowerBound(b);
+    }
+    return 0;
+}
+
+static inline uint64_t nowNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+// ---------- workloads ----------
+
+struct Workload {
+    char name;
+    int readPct, updatePct, scanPct, insertPct;   // per run phase
+    int loadOnly;                                  // I and S measure the load
+    int sequential;
+};
+
+static const struct Workload workloads[] = {
+    {'A', 50, 50, 0, 0, 0, 0},
+    {'B', 95, 5, 0, 0, 0, 0},
+    {'C', 100, 0, 0, 0, 0, 0},
+    {'E', 0, 0, 95, 5, 0, 0},
+    {'I', 0, 0, 0, 0, 1, 0},
+    {'S', 0, 0, 0, 0, 1, 1},
+};
+
+struct Result {
+    double loadMops, runMops;
+    uint64_t p50, p99, p999;
+    double bytesPerKey;
+    int height;
+    uint64_t checksum;
+};
+
+static int sumVisit(uint64_t key, uint64_t *val, void *ctx) {
+    *(uint64_t *)ctx += key ^ *val;
+    return 0;
+}
+
+// One runner per tree, generated from the shared <tree>Map* names
+#define DEFINE_RUNNER(x, MapType)                                                    \
+    static void x##Run(const struct Workload *w, const struct Zipf *zipf,            \
+                       uint64_t keys, uint64_t ops, struct Result *res) {            \
+        struct MapType m;                                                            \
+        struct Histogram hist;                                                       \
+        uint64_t sink = 0, records = keys;                                           \
+        memset(&hist, 0, sizeof(hist));                                              \
+        x##MapInit(&m);                                                              \
+        size_t baseBytes = liveBytes;                                                \
+                                                                                     \
+        uint64_t t0 = nowNs();                                                       \
+        for (uint64_t i = 0; i < keys; i++) {                                        \
+            uint64_t key = w->sequential ? i : mix64(i);                             \
+            if (w->loadOnly && i % LAT_SAMPLE == 0) {                                \
+                uint64_t s = nowNs();                                                \
+                x##MapInsert(&m, key, i);                                            \
+                hist.count[histBucket(nowNs() - s)]++;                               \
+                hist.total++;                                                        \
+            } else {                                                                 \
+                x##MapInsert(&m, key, i);                                            \
+            }                                                                        \
+        }                                                                            \
+        res->loadMops = keys / ((nowNs() - t0) / 1e3);                               \
+        res->bytesPerKey = (double)(liveBytes - baseBytes) / m.size;                 \
+                                                                                     \
+        res->runMops = 0;                                                            \
+        if (!w->loadOnly) {                                                          \
+            t0 = nowNs();                                                            \
+            for (uint64_t i = 0; i < ops; i++) {                                     \
+                int r = (int)(rngNext() % 100);                                      \
+                uint64_t rec = zipf ? mix64(zipfNext(zipf)) % records                \
+                                    : rngNext() % records;                           \
+                uint64_t key = mix64(rec), s = 0;                                    \
+                int timed = i % LAT_SAMPLE == 0;                                     \
+                if (timed) s = nowNs();                                              \
+                if (r < w->readPct) {                                                \
+                    uint64_t *v = x##MapFind(&m, key);                               \
+                    sink += v ? *v : 0;                                              \
+                } else if (r < w->readPct + w->updatePct) {                          \
+                    x##MapInsert(&m, key, i);                                        \
+                } else if (r < w->readPct + w->updatePct + w->scanPct) {             \
+                    x##MapScan(&m, key, 1 + rngNext() % 100, sumVisit, &sink);       \
+                } else {                                                             \
+                    x##MapInsert(&m, mix64(records++), i);                           \
+                }                                                                    \
+                if (timed) {                                                         \
+                    hist.count[histBucket(nowNs() - s)]++;                           \
+                    hist.total++;                                                    \
+                }                                                                    \
+            }                                                                        \
+            res->runMops = ops / ((nowNs() - t0) / 1e3);                             \
+        }                                                                            \
+        res->p50 = histPercentile(&hist, 0.50);                                      \
+        res->p99 = histPercentile(&hist, 0.99);                                      \
+        res->p999 = histPercentile(&hist, 0.999);                                    \
+        res->height = x##MapHeight(&m);                                              \
+        res->checksum = sink;                                                        \
+        x##MapFree(&m);                                                              \
+    }
+
+DEFINE_RUNNER(bst, BstMap)
+DEFINE_RUNNER(avl, AvlMap)
+DEFINE_RUNNER(splay, SplayMap)
+DEFINE_RUNNER(btree, BTreeMap)
+
+struct Tree {
+    const char *name;
+    void (*run)(const struct Workload *, const struct Zipf *, uint64_t, uint64_t, struct Result *);
+};
+
+static const struct Tree trees[] = {
+    {"bst", bstRun},
+    {"avl", avlRun},
+    {"splay", splayRun},
+    {"btree", btreeRun},
+};
+
+int main(int argc, char **argv) {
+    uint64_t keys = argc > 1 ? (uint64_t)atof(argv[1]) : 100000;
+    uint64_t ops = argc > 2 ? (uint64_t)atof(argv[2]) : 1000000;
+    const char *which = argc > 3 ? argv[3] : "ABCEIS";
+    const char *dist = argc > 4 ? argv[4] : "both";
+    const char *treeList = argc > 5 ? argv[5] : "bst,avl,splay,btree";
+
+    struct Zipf zipf;
+    int useUniform = strcmp(dist, "zipfian") != 0;
+    int useZipf = strcmp(dist, "uniform") != 0;
+    if (useZipf)
+        zipfInit(&zipf, keys, 0.99);
+
+    printf("%llu keys, %llu operations, 1 in %d operations timed\n",
+           (unsigned long long)keys, (unsigned long long)ops, LAT_SAMPLE);
+    printf("%-3s %-8s %-6s %10s %10s %8s %8s %8s %10s %7s\n", "wl", "dist", "tree",
+           "load Mop/s", "run Mop/s", "p50 ns", "p99 ns", "p999 ns", "bytes/key", "height");
+
+    for (size_t wi = 0; wi < sizeof(workloads) / sizeof(workloads[0]); wi++) {
+        const struct Workload *w = &workloads[wi];
+        if (strchr(which, w->name) == NULL)
+            continue;
+        for (int d = 0; d < 2; d++) {
+            if ((d == 0 && !useUniform) || (d == 1 && !useZipf))
+                continue;
+            if (w->loadOnly && d == 1)
+                continue;   // load order does not depend on the distribution
+            for (size_t t = 0; t < sizeof(trees) / sizeof(trees[0]); t++) {
+                if (strstr(treeList, trees[t].name) == NULL)
+                    continue;
+                const char *distName = w->loadOnly ? "-" : d ? "zipfian" : "uniform";
+                if (w->sequential && t == 0 && keys > BST_SEQUENTIAL_LIMIT) {
+                    printf("%-3c %-8s %-6s   skipped: sorted input degenerates the BST into a list\n",
+                           w->name, distName, trees[t].name);
+                    continue;
+                }
+                struct Result r;
+                omStatsReset();
+                trees[t].run(w, d ? &zipf : NULL, keys, ops, &r);
+                printf("%-3c %-8s %-6s %10.2f ", w->name, distName, trees[t].name, r.loadMops);
+                if (w->loadOnly)
+                    printf("%10s ", "-");
+                else
+                    printf("%10.2f ", r.runMops);
+                printf("%8llu %8llu %8llu %10.1f %7d\n", (unsigned long long)r.p50,
+                       (unsigned long long)r.p99, (unsigned long long)r.p999, r.bytesPerKey, r.height);
+#ifdef OM_STATS
+                struct OmStats st;
+                omStatsGet(&st);
+                printf("    stats: ");
+                omStatsDumpJson(stdout, &st);
+#endif
+                fflush(stdout);
+            }
+        }
+    }
+    return 0;
+}
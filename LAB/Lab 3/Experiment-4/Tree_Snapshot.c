@@ -0,0 +1,239 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <fcntl.h>
+#include <time.h>
+
+// Save/reload benchmark for tree_snapshot.h: time-to-ready after restart.
+//
+// For the AVL, splay and B-tree maps it compares
+//   - rebuilding by calling insert() for every key (what a restart costs
+//     today) with
+//   - save() once, then load() of the sorted snapshot (O(n) build),
+// and for the B-tree also opening the mmap-able page image, which is
+// ready to serve lookups without building anything. Each reloaded tree
+// is checked against the original, and a corrupted file must be refused.
+// Crafted files are tried too: an image whose root links back to itself
+// must not make a lookup loop (and is refused with verify on), and
+// headers claiming more pages or entries than the file holds are refused,
+// as is an entry snapshot with a valid checksum but keys out of order.
+//
+// Compile:
+//   gcc -O2 -o tree_snapshot Tree_Snapshot.c
+// Run:
+//   ./tree_snapshot [keys] [file]
+//   e.g. ./tree_snapshot 100000000 /data/tree.snap
+
+#define OM_KEY_T uint64_t
+#define OM_VAL_T uint64_t
+#include "tree_snapshot.h"
+
+static double nowSec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static inline uint64_t mix64(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xBF58476D1CE4E5B9ULL;
+    x ^= x >> 27;
+    x *= 0x94D049BB133111EBULL;
+    x ^= x >> 31;
+    return x;
+}
+
+static int hashEntry(uint64_t key, uint64_t *val, void *ctx) {
+    uint64_t *h = (uint64_t *)ctx;
+    *h = (*h ^ key) * 0x100000001B3ULL + *val;
+    return 0;
+}
+
+static long fileSize(int fd) {
+    struct stat st;
+    return fstat(fd, &st) == 0 ? (long)st.st_size : -1;
+}
+
+// Flip one byte in the middle of the file; load must then fail
+static void corrupt(int fd) {
+    long mid = fileSize(fd) / 2;
+    unsigned char b;
+    if (pread(fd, &b, 1, mid) == 1) {
+        b ^= 0x40;
+        if (pwrite(fd, &b, 1, mid) != 1)
+            perror("pwrite");
+    }
+}
+
+// Edits a valid page image in place and tries each edited file; returns
+// how many were accepted where they must not be.
+static int craftedAccepted(int fd) {
+    struct SnapHeader h;
+    struct BTreePage root;
+    struct BTreeImage img;
+    int accepted = 0;
+    if (pread(fd, &h, sizeof(h), 0) != (ssize_t)sizeof(h) ||
+        pread(fd, &root, sizeof(root), sizeof(h)) != (ssize_t)sizeof(root))
+        return 1;
+    if (!root.leaf) {   // root's first child made the root itself: a cycle
+        struct BTreePage bad = root;
+        bad.child[0] = 0;
+        if (pwrite(fd, &bad, sizeof(bad), sizeof(h)) != (ssize_t)sizeof(bad))
+            return 1;
+        // open without verify only reads the header; the lookup of the
+        // smallest key walks into child 0 and must stop there
+        if (btreeImageOpen(&img, fd, 0) == 0) {
+            accepted += btreeImageFind(&img, 0) != NULL;
+            btreeImageClose(&img);
+        }
+        if (btreeImageOpen(&img, fd, 1) == 0) {
+            accepted++;
+            btreeImageClose(&img);
+        }
+        if (pwrite(fd, &root, sizeof(root), sizeof(h)) != (ssize_t)sizeof(root))
+            return accepted + 1;
+    }
+    struct SnapHeader bad = h;   // page count whose byte size overflows
+    bad.pages = UINT64_MAX / sizeof(struct BTreePage) + 2;
+    if (pwrite(fd, &bad, sizeof(bad), 0) == (ssize_t)sizeof(bad) && btreeImageOpen(&img, fd, 0) == 0) {
+        accepted++;
+        btreeImageClose(&img);
+    }
+    // entry snapshot header claiming far more entries than the file holds
+    snapHeaderInit(&bad, SNAP_MAGIC, SNAP_BTREE, UINT64_MAX / 2);
+    struct BTreeMap m;
+    btreeMapInit(&m);
+    if (pwrite(fd, &bad, sizeof(bad), 0) == (ssize_t)sizeof(bad) && btreeMapLoad(&m, fd) == 0) {
+        accepted++;
+        btreeMapFree(&m);
+    }
+    if (pwrite(fd, &h, sizeof(h), 0) != (ssize_t)sizeof(h))
+        return accepted + 1;
+    return accepted;
+}
+
+// Writes an entry snapshot with a correct checksum whose keys are out of
+// order (then repeated); returns how many of the two loads succeeded
+static int unsortedAccepted(int fd) {
+    uint64_t records[2][3][2] = {{{5, 0}, {3, 1}, {7, 2}}, {{3, 0}, {5, 1}, {5, 2}}};
+    int accepted = 0;
+    for (int f = 0; f < 2; f++) {
+        struct SnapHeader h;
+        snapHeaderInit(&h, SNAP_MAGIC, SNAP_AVL, 3);
+        for (int i = 0; i < 3; i++)
+            h.checksum = snapChecksum(snapChecksum(h.checksum, &records[f][i][0], 8), &records[f][i][1], 8);
+        if (ftruncate(fd, 0) != 0 || pwrite(fd, &h, sizeof(h), 0) != (ssize_t)sizeof(h) ||
+            pwrite(fd, records[f], sizeof(records[f]), sizeof(h)) != (ssize_t)sizeof(records[f]))
+            return 1;
+        struct AvlMap m;
+        avlMapInit(&m);
+        if (avlMapLoad(&m, fd) == 0) {
+            accepted++;
+            avlMapFree(&m);
+        }
+    }
+    return accepted;
+}
+
+// Insert rebuild, save, free, load and verify for one tree type
+#define RUN_TREE(x, MapType, label)                                                   \
+    do {                                                                              \
+        struct MapType m;                                                             \
+        uint64_t before = 0, after = 0;                                               \
+        x##MapInit(&m);                                                               \
+        double t0 = nowSec();                                                         \
+        for (uint64_t i = 0; i < n; i++)                                              \
+            x##MapInsert(&m, mix64(i), i);                                            \
+        double tInsert = nowSec() - t0;                                               \
+        x##MapScan(&m, 0, SIZE_MAX, hashEntry, &before);                              \
+        t0 = nowSec();                                                                \
+        int saved = ftruncate(fd, 0) == 0 && x##MapSave(&m, fd) == 0 && fsync(fd) == 0; \
+        double tSave = nowSec() - t0;                                                 \
+        x##MapFree(&m);                                                               \
+        t0 = nowSec();                                                                \
+        int loaded = x##MapLoad(&m, fd) == 0;                                         \
+        double tLoad = nowSec() - t0;                                                 \
+        x##MapScan(&m, 0, SIZE_MAX, hashEntry, &after);                               \
+        int ok = saved && loaded && m.size == n && before == after;                   \
+        for (uint64_t i = 0; ok && i < n; i += 1 + n / 1000) {                        \
+            uint64_t *v = x##MapFind(&m, mix64(i));                                   \
+            ok = v && *v == i;                                                        \
+        }                                                                             \
+        printf("%-6s %12.3f %10.3f %10.3f %10.1f %8d  %s\n", label, tInsert, tSave,    \
+               tLoad, fileSize(fd) / 1e6, x##MapHeight(&m), ok ? "OK" : "FAILED");     \
+        x##MapFree(&m);                                                               \
+        corrupt(fd);                                                                  \
+        if (n > 0 && x##MapLoad(&m, fd) == 0) {                                       \
+            printf("%-6s corrupted snapshot was accepted!\n", label);                 \
+            x##MapFree(&m);                                                           \
+        }                                                                             \
+    } while (0)
+
+int main(int argc, char **argv) {
+    uint64_t n = argc > 1 ? (uint64_t)atof(argv[1]) : 1000000;
+    const char *path = argc > 2 ? argv[2] : "/tmp/tree_snapshot.bin";
+    int fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        perror(path);
+        return 1;
+    }
+
+    printf("%llu keys, snapshot file %s\n", (unsigned long long)n, path);
+    printf("%-6s %12s %10s %10s %10s %8s\n", "tree", "insert() s", "save s", "load s", "file MB", "height");
+    RUN_TREE(avl, AvlMap, "avl");
+    RUN_TREE(splay, SplayMap, "splay");
+    RUN_TREE(btree, BTreeMap, "btree");
+
+    // B-tree page image: ready once mapped
+    struct BTreeMap m;
+    btreeMapInit(&m);
+    for (uint64_t i = 0; i < n; i++)
+        btreeMapInsert(&m, mix64(i), i);
+    if (ftruncate(fd, 0) != 0 || btreeMapSaveImage(&m, fd) != 0 || fsync(fd) != 0) {
+        printf("saving the page image failed\n");
+        return 1;
+    }
+    struct BTreeImage img;
+    double t0 = nowSec();
+    int opened = btreeImageOpen(&img, fd, 0) == 0;
+    double tOpen = nowSec() - t0;
+    int ok = opened;
+    t0 = nowSec();
+    for (uint64_t i = 0; ok && i < n; i += 1 + n / 1000) {
+        const uint64_t *v = btreeImageFind(&img, mix64(i));
+        ok = v && *v == i;
+    }
+    double tFirst = nowSec() - t0;
+    if (opened)
+        btreeImageClose(&img);
+    t0 = nowSec();
+    int verified = btreeImageOpen(&img, fd, 1) == 0;
+    double tVerify = nowSec() - t0;
+    for (uint64_t i = 0; verified && ok && i < n; i += 1 + n / 100000) {
+        const uint64_t *v = btreeImageFind(&img, mix64(i));
+        ok = v && *v == i && *v == *btreeMapFind(&m, mix64(i));
+    }
+    if (verified) {
+        ok &= btreeImageFind(&img, mix64(n)) == NULL;   // never inserted
+        btreeImageClose(&img);
+    }
+    printf("\nB-tree page image: %.1f MB, %llu pages of %zu bytes\n", fileSize(fd) / 1e6,
+           (unsigned long long)((fileSize(fd) - sizeof(struct SnapHeader)) / sizeof(struct BTreePage)),
+           sizeof(struct BTreePage));
+    printf("mmap open: %.6f s, first ~1000 lookups: %.6f s, open with checksum: %.3f s  %s\n",
+           tOpen, tFirst, tVerify, ok && verified ? "OK" : "FAILED");
+    if (n > 0 && craftedAccepted(fd) != 0)
+        printf("crafted image or snapshot was accepted!\n");
+    corrupt(fd);
+    if (n > 0 && btreeImageOpen(&img, fd, 1) == 0) {
+        printf("corrupted image was accepted!\n");
+        btreeImageClose(&img);
+    }
+    if (unsortedAccepted(fd) != 0)
+        printf("snapshot with unsorted keys was accepted!\n");
+
+    btreeMapFree(&m);
+    close(fd);
+    unlink(path);
+    return 0;
+}
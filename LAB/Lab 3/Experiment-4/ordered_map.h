@@ -0,0 +1,1093 @@
+#ifndef ORDERED_MAP_H
+#define ORDERED_MAP_H
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdio.h>
+
+// Common ordered-map interface for the BST, AVL, splay and B-tree.
+//
+// Every tree stores (key, value) pairs and offers the same operations,
+// named <tree>Map<Op> so that a benchmark can switch trees with a macro:
+//
+//   void      xMapInit(struct XMap *m)
+//   int       xMapInsert(struct XMap *m, OM_KEY_T key, OM_VAL_T val)
+//                 1 if the key was added, 0 if its value was replaced
+//   OM_VAL_T* xMapFind(struct XMap *m, OM_KEY_T key)
+//                 pointer to the value, NULL if absent
+//   int       xMapErase(struct XMap *m, OM_KEY_T key)
+//                 1 if the key was removed
+//   int       xMapLowerBound(struct XMap *m, OM_KEY_T key, OM_KEY_T *outKey, OM_VAL_T *outVal)
+//                 smallest entry with key >= key; 0 if there is none
+//   size_t    xMapScan(struct XMap *m, OM_KEY_T from, size_t limit, OmVisit visit, void *ctx)
+//                 visits up to limit entries with key >= from in order,
+//                 stopping early when visit returns nonzero
+//   int       xMapHeight(struct XMap *m)
+//                 number of levels (nodes for the B-tree) on the longest path
+//   void      xMapFree(struct XMap *m)
+//
+// with x in {bst, avl, splay, btree}. Value pointers stay valid until
+// the next insert or erase on the same map.
+//
+// Key and value types and the key order are fixed at compile time, so
+// every comparison is inlined. Define them before including:
+//
+//   #define OM_KEY_T   uint64_t
+//   #define OM_VAL_T   struct Payload
+//   #define OM_LESS(a, b) ((a) < (b))
+//   #include "ordered_map.h"
+//
+// No operation prints. Only the AVL and B-tree recurse, to depth O(log n);
+// the BST and splay tree, which can degenerate into lists, never recurse.
+
+#ifndef OM_KEY_T
+#define OM_KEY_T int64_t
+#endif
+#ifndef OM_VAL_T
+#define OM_VAL_T int64_t
+#endif
+#ifndef OM_LESS
+#define OM_LESS(a, b) ((a) < (b))
+#endif
+#define OM_EQUAL(a, b) (!OM_LT(a, b) && !OM_LT(b, a))
+
+// All node and stack memory goes through these, so a caller can count it
+#ifndef OM_MALLOC
+#define OM_MALLOC(size) malloc(size)
+#endif
+#ifndef OM_FREE
+#define OM_FREE(p) free(p)
+#endif
+
+// ---------- optional instrumentation ----------
+//
+// Compile with -DOM_STATS to count, per thread, what the trees do:
+// rotations, splay steps, B-tree splits and merges, key comparisons, and
+// for every xMapFind the number of comparisons and the depth it reached.
+// Without OM_STATS every counter update compiles to nothing; the
+// omStats* functions still exist and report zeros.
+
+#define OM_DEPTH_BUCKETS 64   // lookups reaching depth >= 63 share the last bucket
+
+struct OmStats {
+    uint64_t rotations;
+    uint64_t zig, zigZig, zigZag;
+    uint64_t splits, merges;
+    uint64_t comparisons;         // all OM_LESS evaluations
+    uint64_t lookups;
+    uint64_t lookupComparisons;   // OM_LESS evaluations inside xMapFind
+    uint64_t depth[OM_DEPTH_BUCKETS];
+};
+
+#ifdef OM_STATS
+static _Thread_local struct OmStats omStats;
+#define OM_STAT(update) ((void)(omStats.update))
+#define OM_LT(a, b) (omStats.comparisons++, OM_LESS(a, b))
+#else
+#define OM_STAT(update) ((void)0)
+#define OM_LT(a, b) OM_LESS(a, b)
+#endif
+
+static inline uint64_t omLookupBegin(void) {
+#ifdef OM_STATS
+    return omStats.comparisons;
+#else
+    return 0;
+#endif
+}
+
+static inline void omLookupEnd(uint64_t begin, int depth) {
+#ifdef OM_STATS
+    omStats.lookups++;
+    omStats.lookupComparisons += omStats.comparisons - begin;
+    omStats.depth[depth < OM_DEPTH_BUCKETS ? depth : OM_DEPTH_BUCKETS - 1]++;
+#else
+    (void)begin;
+    (void)depth;
+#endif
+}
+
+// Counters of the calling thread
+static inline void omStatsGet(struct OmStats *out) {
+#ifdef OM_STATS
+    *out = omStats;
+#else
+    memset(out, 0, sizeof(*out));
+#endif
+}
+
+static inline void omStatsReset(void) {
+#ifdef OM_STATS
+    memset(&omStats, 0, sizeof(omStats));
+#endif
+}
+
+// dst += src, to combine the counters of several threads
+static inline void omStatsAdd(struct OmStats *dst, const struct OmStats *src) {
+    uint64_t *d = (uint64_t *)dst;
+    const uint64_t *s = (const uint64_t *)src;
+    for (size_t i = 0; i < sizeof(struct OmStats) / sizeof(uint64_t); i++)
+        d[i] += s[i];
+}
+
+static inline void omStatsDumpJson(FILE *f, const struct OmStats *st) {
+    fprintf(f, "{\"rotations\": %llu, \"zig\": %llu, \"zig_zig\": %llu, \"zig_zag\": %llu, "
+               "\"splits\": %llu, \"merges\": %llu, \"comparisons\": %llu, \"lookups\": %llu, "
+               "\"comparisons_per_lookup\": %.2f, \"depth_histogram\": [",
+            (unsigned long long)st->rotations, (unsigned long long)st->zig,
+            (unsigned long long)st->zigZig, (unsigned long long)st->zigZag,
+            (unsigned long long)st->splits, (unsigned long long)st->merges,
+            (unsigned long long)st->comparisons, (unsigned long long)st->lookups,
+            st->lookups ? (double)st->lookupComparisons / st->lookups : 0.0);
+    int last = OM_DEPTH_BUCKETS - 1;
+    while (last > 0 && st->depth[last] == 0)
+        last--;
+    for (int d = 0; d <= last; d++)
+        fprintf(f, "%s%llu", d ? ", " : "", (unsigned long long)st->depth[d]);
+    fprintf(f, "]}\n");
+}
+
+// B-tree minimum degree: nodes hold OM_BTREE_T-1 .. 2*OM_BTREE_T-1 keys
+#ifndef OM_BTREE_T
+#define OM_BTREE_T 16
+#endif
+#define OM_BTREE_MAX (2 * OM_BTREE_T - 1)
+
+typedef int (*OmVisit)(OM_KEY_T key, OM_VAL_T *val, void *ctx);
+
+// ---------- explicit stack for iterative traversals ----------
+
+struct OmStack {
+    void **items;
+    size_t count, cap;
+    void *local[64];   // enough for any balanced tree; grows on the heap beyond
+};
+
+static inline void omStackInit(struct OmStack *s) {
+    s->items = s->local;
+    s->count = 0;
+    s->cap = 64;
+}
+
+static inline void omStackPush(struct OmStack *s, void *p) {
+    if (s->count == s->cap) {
+        void **grown = (void **)OM_MALLOC(sizeof(void *) * s->cap * 2);
+        for (size_t i = 0; i < s->count; i++)
+            grown[i] = s->items[i];
+        if (s->items != s->local)
+            OM_FREE(s->items);
+        s->items = grown;
+        s->cap *= 2;
+    }
+    s->items[s->count++] = p;
+}
+
+static inline void omStackFree(struct OmStack *s) {
+    if (s->items != s->local)
+        OM_FREE(s->items);
+}
+
+// ---------- plain BST (iterative, no parent pointers) ----------
+
+struct BstNode {
+    OM_KEY_T key;
+    OM_VAL_T val;
+    struct BstNode *left, *right;
+};
+
+struct BstMap {
+    struct BstNode *root;
+    size_t size;
+};
+
+static inline void bstMapInit(struct BstMap *m) {
+    m->root = NULL;
+    m->size = 0;
+}
+
+static inline int bstMapInsert(struct BstMap *m, OM_KEY_T key, OM_VAL_T val) {
+    struct BstNode **link = &m->root;
+    while (*link) {
+        struct BstNode *n = *link;
+        if (OM_LT(key, n->key))
+            link = &n->left;
+        else if (OM_LT(n->key, key))
+            link = &n->right;
+        else {
+            n->val = val;
+            return 0;
+        }
+    }
+    struct BstNode *n = (struct BstNode *)OM_MALLOC(sizeof(struct BstNode));
+    n->key = key;
+    n->val = val;
+    n->left = n->right = NULL;
+    *link = n;
+    m->size++;
+    return 1;
+}
+
+static inline OM_VAL_T *bstMapFind(struct BstMap *m, OM_KEY_T key) {
+    struct BstNode *n = m->root;
+    uint64_t mark = omLookupBegin();
+    int depth = 0;
+    while (n) {
+        depth++;
+        if (OM_LT(key, n->key))
+            n = n->left;
+        else if (OM_LT(n->key, key))
+            n = n->right;
+        else
+            break;
+    }
+    omLookupEnd(mark, depth);
+    return n ? &n->val : NULL;
+}
+
+static inline int bstMapErase(struct BstMap *m, OM_KEY_T key) {
+    struct BstNode **link = &m->root;
+    while (*link && !OM_EQUAL(key, (*link)->key))
+        link = OM_LT(key, (*link)->key) ? &(*link)->left : &(*link)->right;
+    struct BstNode *n = *link;
+    if (n == NULL)
+        return 0;
+    if (n->left && n->right) {
+        // move the in-order successor's entry here and unlink the successor
+        struct BstNode **succLink = &n->right;
+        while ((*succLink)->left)
+            succLink = &(*succLink)->left;
+        struct BstNode *succ = *succLink;
+        n->key = succ->key;
+        n->val = succ->val;
+        *succLink = succ->right;
+        n = succ;
+    } else {
+        *link = n->left ? n->left : n->right;
+    }
+    OM_FREE(n);
+    m->size--;
+    return 1;
+}
+
+static inline int bstMapLowerBound(struct BstMap *m, OM_KEY_T key, OM_KEY_T *outKey, OM_VAL_T *outVal) {
+    struct BstNode *n = m->root, *best = NULL;
+    while (n) {
+        if (OM_LT(n->key, key))
+            n = n->right;
+        else {
+            best = n;
+            n = n->left;
+        }
+    }
+    if (best == NULL)
+        return 0;
+    if (outKey) *outKey = best->key;
+    if (outVal) *outVal = best->val;
+    return 1;
+}
+
+static inline size_t bstMapScan(struct BstMap *m, OM_KEY_T from, size_t limit, OmVisit visit, void *ctx) {
+    struct OmStack s;
+    size_t visited = 0;
+    omStackInit(&s);
+    // the stack holds the nodes >= from whose right part is still pending
+    for (struct BstNode *n = m->root; n;) {
+        if (OM_LT(n->key, from))
+            n = n->right;
+        else {
+            omStackPush(&s, n);
+            n = n->left;
+        }
+    }
+    while (s.count && visited < limit) {
+        struct BstNode *n = (struct BstNode *)s.items[--s.count];
+        visited++;
+        if (visit && visit(n->key, &n->val, ctx))
+            break;
+        for (n = n->right; n; n = n->left)
+            omStackPush(&s, n);
+    }
+    omStackFree(&s);
+    return visited;
+}
+
+// Frees any binary tree in O(1) space by rotating left children up
+#define OM_FREE_BINARY(NodeType, root)                        \
+    do {                                                      \
+        NodeType *n_ = (root);                                \
+        while (n_) {                                          \
+            if (n_->left) {                                   \
+                NodeType *l_ = n_->left;                      \
+                n_->left = l_->right;                         \
+                l_->right = n_;                               \
+                n_ = l_;                                      \
+            } else {                                          \
+                NodeType *r_ = n_->right;                     \
+                OM_FREE(n_);                                  \
+                n_ = r_;                                      \
+            }                                                 \
+        }                                                     \
+    } while (0)
+
+// Height of any binary tree by an explicit-stack DFS (node, depth pairs)
+#define OM_HEIGHT_BINARY(NodeType, root, out)                 \
+    do {                                                      \
+        struct OmStack s_;                                    \
+        omStackInit(&s_);                                     \
+        (out) = 0;                                            \
+        if (root) {                                           \
+            omStackPush(&s_, (root));                         \
+            omStackPush(&s_, (void *)(uintptr_t)1);           \
+        }                                                     \
+        while (s_.count) {                                    \
+            int d_ = (int)(uintptr_t)s_.items[--s_.count];    \
+            NodeType *n_ = (NodeType *)s_.items[--s_.count];  \
+            void *next_ = (void *)(uintptr_t)(d_ + 1);        \
+            if (d_ > (out))                                   \
+                (out) = d_;                                   \
+            if (n_->left) {                                   \
+                omStackPush(&s_, n_->left);                   \
+                omStackPush(&s_, next_);                      \
+            }                                                 \
+            if (n_->right) {                                  \
+                omStackPush(&s_, n_->right);                  \
+                omStackPush(&s_, next_);                      \
+            }                                                 \
+        }                                                     \
+        omStackFree(&s_);                                     \
+    } while (0)
+
+static inline int bstMapHeight(struct BstMap *m) {
+    int h;
+    OM_HEIGHT_BINARY(struct BstNode, m->root, h);
+    return h;
+}
+
+static inline void bstMapFree(struct BstMap *m) {
+    OM_FREE_BINARY(struct BstNode, m->root);
+    bstMapInit(m);
+}
+
+// ---------- AVL (recursive like AVL-Tree_Operations.c, depth O(log n)) ----------
+
+struct AvlNode {
+    OM_KEY_T key;
+    OM_VAL_T val;
+    struct AvlNode *left, *right;
+    int height;
+};
+
+struct AvlMap {
+    struct AvlNode *root;
+    size_t size;
+};
+
+static inline int avlHeight(struct AvlNode *n) {
+    return n ? n->height : 0;
+}
+
+static inline void avlUpdate(struct AvlNode *n) {
+    int l = avlHeight(n->left), r = avlHeight(n->right);
+    n->height = (l > r ? l : r) + 1;
+}
+
+static inline struct AvlNode *avlRightRotate(struct AvlNode *y) {
+    struct AvlNode *x = y->left;
+    OM_STAT(rotations++);
+    y->left = x->right;
+    x->right = y;
+    avlUpdate(y);
+    avlUpdate(x);
+    return x;
+}
+
+static inline struct AvlNode *avlLeftRotate(struct AvlNode *x) {
+    struct AvlNode *y = x->right;
+    OM_STAT(rotations++);
+    x->right = y->left;
+    y->left = x;
+    avlUpdate(x);
+    avlUpdate(y);
+    return y;
+}
+
+static inline struct AvlNode *avlRebalance(struct AvlNode *n) {
+    avlUpdate(n);
+    int balance = avlHeight(n->left) - avlHeight(n->right);
+    if (balance > 1) {
+        if (avlHeight(n->left->left) < avlHeight(n->left->right))
+            n->left = avlLeftRotate(n->left);
+        return avlRightRotate(n);
+    }
+    if (balance < -1) {
+        if (avlHeight(n->right->right) < avlHeight(n->right->left))
+            n->right = avlRightRotate(n->right);
+        return avlLeftRotate(n);
+    }
+    return n;
+}
+
+static inline struct AvlNode *avlInsertRec(struct AvlNode *n, OM_KEY_T key, OM_VAL_T val, int *added) {
+    if (n == NULL) {
+        n = (struct AvlNode *)OM_MALLOC(sizeof(struct AvlNode));
+        n->key = key;
+        n->val = val;
+        n->left = n->right = NULL;
+        n->height = 1;
+        *added = 1;
+        return n;
+    }
+    if (OM_LT(key, n->key))
+        n->left = avlInsertRec(n->left, key, val, added);
+    else if (OM_LT(n->key, key))
+        n->right = avlInsertRec(n->right, key, val, added);
+    else {
+        n->val = val;
+        return n;
+    }
+    return *added ? avlRebalance(n) : n;
+}
+
+static inline struct AvlNode *avlEraseRec(struct AvlNode *n, OM_KEY_T key, int *removed) {
+    if (n == NULL)
+        return NULL;
+    if (OM_LT(key, n->key))
+        n->left = avlEraseRec(n->left, key, removed);
+    else if (OM_LT(n->key, key))
+        n->right = avlEraseRec(n->right, key, removed);
+    else {
+        *removed = 1;
+        if (n->left == NULL || n->right == NULL) {
+            struct AvlNode *child = n->left ? n->left : n->right;
+            OM_FREE(n);
+            return child;
+        }
+        struct AvlNode *succ = n->right;
+        while (succ->left)
+            succ = succ->left;
+        n->key = succ->key;
+        n->val = succ->val;
+        int dummy = 0;
+        n->right = avlEraseRec(n->right, succ->key, &dummy);
+    }
+    return *removed ? avlRebalance(n) : n;
+}
+
+static inline void avlMapInit(struct AvlMap *m) {
+    m->root = NULL;
+    m->size = 0;
+}
+
+static inline int avlMapInsert(struct AvlMap *m, OM_KEY_T key, OM_VAL_T val) {
+    int added = 0;
+    m->root = avlInsertRec(m->root, key, val, &added);
+    m->size += added;
+    return added;
+}
+
+static inline OM_VAL_T *avlMapFind(struct AvlMap *m, OM_KEY_T key) {
+    struct AvlNode *n = m->root;
+    uint64_t mark = omLookupBegin();
+    int depth = 0;
+    while (n) {
+        depth++;
+        if (OM_LT(key, n->key))
+            n = n->left;
+        else if (OM_LT(n->key, key))
+            n = n->right;
+        else
+            break;
+    }
+    omLookupEnd(mark, depth);
+    return n ? &n->val : NULL;
+}
+
+static inline int avlMapErase(struct AvlMap *m, OM_KEY_T key) {
+    int removed = 0;
+    m->root = avlEraseRec(m->root, key, &removed);
+    m->size -= removed;
+    return removed;
+}
+
+static inline int avlMapLowerBound(struct AvlMap *m, OM_KEY_T key, OM_KEY_T *outKey, OM_VAL_T *outVal) {
+    struct AvlNode *n = m->root, *best = NULL;
+    while (n) {
+        if (OM_LT(n->key, key))
+            n = n->right;
+        else {
+            best = n;
+            n = n->left;
+        }
+    }
+    if (best == NULL)
+        return 0;
+    if (outKey) *outKey = best->key;
+    if (outVal) *outVal = best->val;
+    return 1;
+}
+
+static inline size_t avlMapScan(struct AvlMap *m, OM_KEY_T from, size_t limit, OmVisit visit, void *ctx) {
+    struct OmStack s;
+    size_t visited = 0;
+    omStackInit(&s);
+    for (struct AvlNode *n = m->root; n;) {
+        if (OM_LT(n->key, from))
+            n = n->right;
+        else {
+            omStackPush(&s, n);
+            n = n->left;
+        }
+    }
+    while (s.count && visited < limit) {
+        struct AvlNode *n = (struct AvlNode *)s.items[--s.count];
+        visited++;
+        if (visit && visit(n->key, &n->val, ctx))
+            break;
+        for (n = n->right; n; n = n->left)
+            omStackPush(&s, n);
+    }
+    omStackFree(&s);
+    return visited;
+}
+
+static inline int avlMapHeight(struct AvlMap *m) {
+    return avlHeight(m->root);
+}
+
+static inline void avlMapFree(struct AvlMap *m) {
+    OM_FREE_BINARY(struct AvlNode, m->root);
+    avlMapInit(m);
+}
+
+// ---------- bottom-up splay tree (parent pointers, as Lab 8/splay.c) ----------
+
+struct SplayNode {
+    OM_KEY_T key;
+    OM_VAL_T val;
+    struct SplayNode *left, *right, *parent;
+};
+
+struct SplayMap {
+    struct SplayNode *root;
+    size_t size;
+};
+
+// Rotate x above its parent
+static inline void splayRotateUp(struct SplayNode **root, struct SplayNode *x) {
+    struct SplayNode *p = x->parent, *g = p->parent;
+    OM_STAT(rotations++);
+    if (x == p->left) {
+        p->left = x->right;
+        if (x->right) x->right->parent = p;
+        x->right = p;
+    } else {
+        p->right = x->left;
+        if (x->left) x->left->parent = p;
+        x->left = p;
+    }
+    p->parent = x;
+    x->parent = g;
+    if (g == NULL) *root = x;
+    else if (g->left == p) g->left = x;
+    else g->right = x;
+}
+
+static inline void splayNode(struct SplayNode **root, struct SplayNode *x) {
+    while (x->parent) {
+        struct SplayNode *p = x->parent, *g = p->parent;
+        if (g == NULL) {
+            OM_STAT(zig++);
+            splayRotateUp(root, x);
+        } else if ((x == p->left) == (p == g->left)) {
+            OM_STAT(zigZig++);
+            splayRotateUp(root, p);
+            splayRotateUp(root, x);
+        } else {
+            OM_STAT(zigZag++);
+            splayRotateUp(root, x);
+            splayRotateUp(root, x);
+        }
+    }
+}
+
+// Last node on the search path for key (the node itself if present);
+// *depth receives the number of nodes visited
+static inline struct SplayNode *splayDescend(struct SplayNode *n, OM_KEY_T key, int *depth) {
+    struct SplayNode *last = NULL;
+    *depth = 0;
+    while (n) {
+        last = n;
+        (*depth)++;
+        if (OM_LT(key, n->key))
+            n = n->left;
+        else if (OM_LT(n->key, key))
+            n = n->right;
+        else
+            break;
+    }
+    return last;
+}
+
+static inline void splayMapInit(struct SplayMap *m) {
+    m->root = NULL;
+    m->size = 0;
+}
+
+static inline int splayMapInsert(struct SplayMap *m, OM_KEY_T key, OM_VAL_T val) {
+    int depth;
+    struct SplayNode *parent = splayDescend(m->root, key, &depth);
+    if (parent && OM_EQUAL(key, parent->key)) {
+        parent->val = val;
+        splayNode(&m->root, parent);
+        return 0;
+    }
+    struct SplayNode *n = (struct SplayNode *)OM_MALLOC(sizeof(struct SplayNode));
+    n->key = key;
+    n->val = val;
+    n->left = n->right = NULL;
+    n->parent = parent;
+    if (parent == NULL) m->root = n;
+    else if (OM_LT(key, parent->key)) parent->left = n;
+    else parent->right = n;
+    splayNode(&m->root, n);
+    m->size++;
+    return 1;
+}
+
+static inline OM_VAL_T *splayMapFind(struct SplayMap *m, OM_KEY_T key) {
+    uint64_t mark = omLookupBegin();
+    int depth;
+    struct SplayNode *last = splayDescend(m->root, key, &depth);
+    int found = last && OM_EQUAL(key, last->key);
+    omLookupEnd(mark, depth);
+    if (last == NULL)
+        return NULL;
+    splayNode(&m->root, last);
+    return found ? &last->val : NULL;
+}
+
+static inline int splayMapErase(struct SplayMap *m, OM_KEY_T key) {
+    int depth;
+    struct SplayNode *n = splayDescend(m->root, key, &depth);
+    if (n == NULL)
+        return 0;
+    splayNode(&m->root, n);
+    if (!OM_EQUAL(key, n->key))
+        return 0;
+    struct SplayNode *l = n->left, *r = n->right;
+    if (l == NULL) {
+        m->root = r;
+        if (r) r->parent = NULL;
+    } else {
+        // splay the maximum of the left subtree up; it has no right child
+        l->parent = NULL;
+        struct SplayNode *mx = l;
+        while (mx->right)
+            mx = mx->right;
+        splayNode(&l, mx);
+        mx->right = r;
+        if (r) r->parent = mx;
+        m->root = mx;
+    }
+    OM_FREE(n);
+    m->size--;
+    return 1;
+}
+
+static inline struct SplayNode *splaySuccessor(struct SplayNode *n) {
+    if (n->right) {
+        for (n = n->right; n->left; n = n->left);
+        return n;
+    }
+    while (n->parent && n == n->parent->right)
+        n = n->parent;
+    return n->parent;
+}
+
+// Smallest node >= key, splaying the search path
+static inline struct SplayNode *splayLowerNode(struct SplayMap *m, OM_KEY_T key) {
+    int depth;
+    struct SplayNode *last = splayDescend(m->root, key, &depth);
+    if (last == NULL)
+        return NULL;
+    splayNode(&m->root, last);
+    return OM_LT(last->key, key) ? splaySuccessor(last) : last;
+}
+
+static inline int splayMapLowerBound(struct SplayMap *m, OM_KEY_T key, OM_KEY_T *outKey, OM_VAL_T *outVal) {
+    struct SplayNode *n = splayLowerNode(m, key);
+    if (n == NULL)
+        return 0;
+    if (outKey) *outKey = n->key;
+    if (outVal) *outVal = n->val;
+    return 1;
+}
+
+// Only the start of the range is splayed; the walk uses parent pointers
+static inline size_t splayMapScan(struct SplayMap *m, OM_KEY_T from, size_t limit, OmVisit visit, void *ctx) {
+    size_t visited = 0;
+    for (struct SplayNode *n = splayLowerNode(m, from); n && visited < limit; n = splaySuccessor(n)) {
+        visited++;
+        if (visit && visit(n->key, &n->val, ctx))
+            break;
+    }
+    return visited;
+}
+
+static inline int splayMapHeight(struct SplayMap *m) {
+    int h;
+    OM_HEIGHT_BINARY(struct SplayNode, m->root, h);
+    return h;
+}
+
+static inline void splayMapFree(struct SplayMap *m) {
+    OM_FREE_BINARY(struct SplayNode, m->root);
+    splayMapInit(m);
+}
+
+// ---------- B-tree (CLRS style, single pass insert and delete) ----------
+
+struct BTreeNode {
+    int count;
+    int leaf;
+    OM_KEY_T keys[OM_BTREE_MAX];
+    OM_VAL_T vals[OM_BTREE_MAX];
+};
+
+// Inner nodes append the child links; leaves are allocated without them
+struct BTreeInner {
+    struct BTreeNode base;
+    struct BTreeNode *child[OM_BTREE_MAX + 1];
+};
+
+struct BTreeMap {
+    struct BTreeNode *root;
+    size_t size;
+    int height;
+};
+
+static inline struct BTreeNode **btreeChild(struct BTreeNode *n) {
+    return ((struct BTreeInner *)n)->child;
+}
+
+static inline struct BTreeNode *btreeNewNode(int leaf) {
+    size_t bytes = leaf ? sizeof(struct BTreeNode) : sizeof(struct BTreeInner);
+    struct BTreeNode *n = (struct BTreeNode *)OM_MALLOC(bytes);
+    n->count = 0;
+    n->leaf = leaf;
+    return n;
+}
+
+// First index i with keys[i] >= key
+static inline int btreeLowerIndex(const struct BTreeNode *n, OM_KEY_T key) {
+    int lo = 0, hi = n->count;
+    while (lo < hi) {
+        int mid = (lo + hi) >> 1;
+        if (OM_LT(n->keys[mid], key))
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
+static inline void btreeMoveEntries(struct BTreeNode *dst, int d, struct BTreeNode *src, int s, int count) {
+    // memmove semantics so callers can shift within one node
+    if (dst == src && d > s) {
+        for (int i = count - 1; i >= 0; i--) {
+            dst->keys[d + i] = src->keys[s + i];
+            dst->vals[d + i] = src->vals[s + i];
+        }
+    } else {
+        for (int i = 0; i < count; i++) {
+            dst->keys[d + i] = src->keys[s + i];
+            dst->vals[d + i] = src->vals[s + i];
+        }
+    }
+}
+
+static inline void btreeMoveChildren(struct BTreeNode *dst, int d, struct BTreeNode *src, int s, int count) {
+    if (dst == src && d > s) {
+        for (int i = count - 1; i >= 0; i--)
+            btreeChild(dst)[d + i] = btreeChild(src)[s + i];
+    } else {
+        for (int i = 0; i < count; i++)
+            btreeChild(dst)[d + i] = btreeChild(src)[s + i];
+    }
+}
+
+// Split the full child i of x around its median, which moves up into x
+static inline void btreeSplitChild(struct BTreeNode *x, int i) {
+    struct BTreeNode *y = btreeChild(x)[i];
+    OM_STAT(splits++);
+    struct BTreeNode *z = btreeNewNode(y->leaf);
+    z->count = OM_BTREE_T - 1;
+    btreeMoveEntries(z, 0, y, OM_BTREE_T, OM_BTREE_T - 1);
+    if (!y->leaf)
+        btreeMoveChildren(z, 0, y, OM_BTREE_T, OM_BTREE_T);
+    y->count = OM_BTREE_T - 1;
+    btreeMoveChildren(x, i + 2, x, i + 1, x->count - i);
+    btreeMoveEntries(x, i + 1, x, i, x->count - i);
+    btreeChild(x)[i + 1] = z;
+    x->keys[i] = y->keys[OM_BTREE_T - 1];
+    x->vals[i] = y->vals[OM_BTREE_T - 1];
+    x->count++;
+}
+
+// Merge child i, entry i and child i+1 of x into child i
+static inline void btreeMerge(struct BTreeNode *x, int i) {
+    struct BTreeNode *y = btreeChild(x)[i], *z = btreeChild(x)[i + 1];
+    OM_STAT(merges++);
+    y->keys[y->count] = x->keys[i];
+    y->vals[y->count] = x->vals[i];
+    btreeMoveEntries(y, y->count + 1, z, 0, z->count);
+    if (!y->leaf)
+        btreeMoveChildren(y, y->count + 1, z, 0, z->count + 1);
+    y->count += z->count + 1;
+    btreeMoveEntries(x, i, x, i + 1, x->count - i - 1);
+    btreeMoveChildren(x, i + 1, x, i + 2, x->count - i - 1);
+    x->count--;
+    OM_FREE(z);
+}
+
+// Make sure child i of x has at least OM_BTREE_T keys; returns the child to descend into
+static inline int btreeFill(struct BTreeNode *x, int i) {
+    struct BTreeNode *c = btreeChild(x)[i];
+    if (c->count >= OM_BTREE_T)
+        return i;
+    if (i > 0 && btreeChild(x)[i - 1]->count >= OM_BTREE_T) {
+        // borrow through the parent from the left sibling
+        struct BTreeNode *l = btreeChild(x)[i - 1];
+        btreeMoveEntries(c, 1, c, 0, c->count);
+        if (!c->leaf) {
+            btreeMoveChildren(c, 1, c, 0, c->count + 1);
+            btreeChild(c)[0] = btreeChild(l)[l->count];
+        }
+        c->keys[0] = x->keys[i - 1];
+        c->vals[0] = x->vals[i - 1];
+        x->keys[i - 1] = l->keys[l->count - 1];
+        x->vals[i - 1] = l->vals[l->count - 1];
+        c->count++;
+        l->count--;
+        return i;
+    }
+    if (i < x->count && btreeChild(x)[i + 1]->count >= OM_BTREE_T) {
+        struct BTreeNode *r = btreeChild(x)[i + 1];
+        c->keys[c->count] = x->keys[i];
+        c->vals[c->count] = x->vals[i];
+        if (!c->leaf)
+            btreeChild(c)[c->count + 1] = btreeChild(r)[0];
+        x->keys[i] = r->keys[0];
+        x->vals[i] = r->vals[0];
+        btreeMoveEntries(r, 0, r, 1, r->count - 1);
+        if (!r->leaf)
+            btreeMoveChildren(r, 0, r, 1, r->count);
+        c->count++;
+        r->count--;
+        return i;
+    }
+    if (i < x->count) {
+        btreeMerge(x, i);
+        return i;
+    }
+    btreeMerge(x, i - 1);
+    return i - 1;
+}
+
+static inline void btreeMapInit(struct BTreeMap *m) {
+    m->root = NULL;
+    m->size = 0;
+    m->height = 0;
+}
+
+static inline int btreeMapInsert(struct BTreeMap *m, OM_KEY_T key, OM_VAL_T val) {
+    if (m->root == NULL) {
+        m->root = btreeNewNode(1);
+        m->height = 1;
+    }
+    if (m->root->count == OM_BTREE_MAX) {
+        struct BTreeNode *s = btreeNewNode(0);
+        btreeChild(s)[0] = m->root;
+        btreeSplitChild(s, 0);
+        m->root = s;
+        m->height++;
+    }
+    struct BTreeNode *x = m->root;
+    for (;;) {
+        int i = btreeLowerIndex(x, key);
+        if (i < x->count && !OM_LT(key, x->keys[i])) {
+            x->vals[i] = val;
+            return 0;
+        }
+        if (x->leaf) {
+            btreeMoveEntries(x, i + 1, x, i, x->count - i);
+            x->keys[i] = key;
+            x->vals[i] = val;
+            x->count++;
+            m->size++;
+            return 1;
+        }
+        if (btreeChild(x)[i]->count == OM_BTREE_MAX) {
+            btreeSplitChild(x, i);
+            if (OM_LT(x->keys[i], key))
+                i++;
+            else if (!OM_LT(key, x->keys[i])) {
+                x->vals[i] = val;
+                return 0;
+            }
+        }
+        x = btreeChild(x)[i];
+    }
+}
+
+static inline OM_VAL_T *btreeLookup(struct BTreeMap *m, OM_KEY_T key, int *depth) {
+    struct BTreeNode *x = m->root;
+    *depth = 0;
+    while (x) {
+        int i = btreeLowerIndex(x, key);
+        (*depth)++;
+        if (i < x->count && !OM_LT(key, x->keys[i]))
+            return &x->vals[i];
+        x = x->leaf ? NULL : btreeChild(x)[i];
+    }
+    return NULL;
+}
+
+static inline OM_VAL_T *btreeMapFind(struct BTreeMap *m, OM_KEY_T key) {
+    uint64_t mark = omLookupBegin();
+    int depth;
+    OM_VAL_T *v = btreeLookup(m, key, &depth);
+    omLookupEnd(mark, depth);
+    return v;
+}
+
+static inline int btreeMapErase(struct BTreeMap *m, OM_KEY_T key) {
+    int depth;
+    if (m->root == NULL || btreeLookup(m, key, &depth) == NULL)
+        return 0;
+    struct BTreeNode *x = m->root;
+    for (;;) {
+        int i = btreeLowerIndex(x, key);
+        int found = i < x->count && !OM_LT(key, x->keys[i]);
+        if (x->leaf) {
+            // found is guaranteed: the key exists and every step kept it below x
+            btreeMoveEntries(x, i, x, i + 1, x->count - i - 1);
+            x->count--;
+            break;
+        }
+        if (found) {
+            struct BTreeNode *l = btreeChild(x)[i], *r = btreeChild(x)[i + 1];
+            if (l->count >= OM_BTREE_T) {
+                // replace by the predecessor and delete that from the left child
+                struct BTreeNode *p = l;
+                while (!p->leaf)
+                    p = btreeChild(p)[p->count];
+                x->keys[i] = p->keys[p->count - 1];
+                x->vals[i] = p->vals[p->count - 1];
+                key = x->keys[i];
+                x = l;
+            } else if (r->count >= OM_BTREE_T) {
+                struct BTreeNode *s = r;
+                while (!s->leaf)
+                    s = btreeChild(s)[0];
+                x->keys[i] = s->keys[0];
+                x->vals[i] = s->vals[0];
+                key = x->keys[i];
+                x = r;
+            } else {
+                btreeMerge(x, i);
+                x = l;
+            }
+        } else {
+            x = btreeChild(x)[btreeFill(x, i)];
+        }
+        if (m->root->count == 0 && !m->root->leaf) {
+            struct BTreeNode *old = m->root;
+            m->root = btreeChild(old)[0];
+            OM_FREE(old);
+            m->height--;
+        }
+    }
+    if (m->root->count == 0) {
+        OM_FREE(m->root);
+        m->root = NULL;
+        m->height = 0;
+    }
+    m->size--;
+    return 1;
+}
+
+static inline int btreeMapLowerBound(struct BTreeMap *m, OM_KEY_T key, OM_KEY_T *outKey, OM_VAL_T *outVal) {
+    struct BTreeNode *x = m->root, *best = NULL;
+    int bestIndex = 0;
+    while (x) {
+        int i = btreeLowerIndex(x, key);
+        if (i < x->count) {
+            best = x;
+            bestIndex = i;
+            if (!OM_LT(key, x->keys[i]))
+                break;
+        }
+        x = x->leaf ? NULL : btreeChild(x)[i];
+    }
+    if (best == NULL)
+        return 0;
+    if (outKey) *outKey = best->keys[bestIndex];
+    if (outVal) *outVal = best->vals[bestIndex];
+    return 1;
+}
+
+static inline size_t btreeMapScan(struct BTreeMap *m, OM_KEY_T from, size_t limit, OmVisit visit, void *ctx) {
+    // path of (node, next entry index); B-tree height stays far below 64
+    struct BTreeNode *node[64];
+    int next[64];
+    int depth = 0;
+    size_t visited = 0;
+    for (struct BTreeNode *x = m->root; x;) {
+        int i = btreeLowerIndex(x, from);
+        node[depth] = x;
+        next[depth++] = i;
+        if (x->leaf || (i < x->count && !OM_LT(from, x->keys[i])))
+            break;
+        x = btreeChild(x)[i];
+    }
+    while (depth > 0 && visited < limit) {
+        struct BTreeNode *x = node[depth - 1];
+        int i = next[depth - 1];
+        if (i >= x->count) {
+            depth--;
+            continue;
+        }
+        visited++;
+        if (visit && visit(x->keys[i], &x->vals[i], ctx))
+            break;
+        next[depth - 1] = i + 1;
+        if (!x->leaf) {
+            for (struct BTreeNode *c = btreeChild(x)[i + 1]; c; c = c->leaf ? NULL : btreeChild(c)[0]) {
+                node[depth] = c;
+                next[depth++] = 0;
+            }
+        }
+    }
+    return visited;
+}
+
+static inline int btreeMapHeight(struct BTreeMap *m) {
+    return m->height;
+}
+
+static inline void btreeFreeNode(struct BTreeNode *x) {
+    if (!x->leaf)
+        for (int i = 0; i <= x->count; i++)
+            btreeFreeNode(btreeChild(x)[i]);
+    OM_FREE(x);
+}
+
+static inline void btreeMapFree(struct BTreeMap *m) {
+    if (m->root)
+        btreeFreeNode(m->root);
+    btreeMapInit(m);
+}
+
+#endif
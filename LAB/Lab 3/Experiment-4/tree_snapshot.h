@@ -0,0 +1,528 @@
+#ifndef TREE_SNAPSHOT_H
+#define TREE_SNAPSHOT_H
+
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "ordered_map.h"
+
+// Binary save/load for the ordered_map.h trees.
+//
+// Entry snapshot (AVL, splay, B-tree):
+//
+//   struct SnapHeader                     64 bytes
+//   count x (key, value)                  in ascending key order
+//
+// The entries are written in order, with no shape information, so the
+// file is as small as the data. Loading reads them back into one array
+// and builds a perfectly balanced tree (a minimum-height B-tree) in
+// O(n) without a single comparison or rotation. The header records the
+// key and value sizes and a 64-bit checksum over all entries; load
+// rejects a file that does not match. A snapshot saved from one tree can
+// be loaded into any other.
+//
+//   int xMapSave(struct XMap *m, int fd)    0 on success, -1 on error
+//   int xMapLoad(struct XMap *m, int fd)    m must be empty (initialised)
+//
+// B-tree page image: the B-tree's nodes as fixed-size pages in level
+// order (root first, child links are page numbers). btreeImageOpen()
+// mmaps the file and btreeImageFind() searches the pages in place, so
+// the tree is ready without building any nodes. Open only checks the
+// header, so it costs O(1) whatever the image size; pages are faulted in
+// on first use. Each page a search visits is checked on the way (key
+// count within the page, child links pointing forward to an existing
+// page), so a truncated or crafted file cannot send a search out of the
+// mapping or around a cycle: a bad page ends the search as not found.
+// Open with verify set checks every page and the checksum up front,
+// which reads the whole file.
+//
+//   int btreeMapSaveImage(struct BTreeMap *m, int fd)
+//   int btreeImageOpen(struct BTreeImage *img, int fd, int verify)
+//   const OM_VAL_T *btreeImageFind(const struct BTreeImage *img, OM_KEY_T key)
+//   void btreeImageClose(struct BTreeImage *img)
+//
+// Files are written with write()/pwrite(), so fd must be a regular
+// file opened for reading and writing. The format uses the host's byte
+// order and the compiled-in OM_KEY_T/OM_VAL_T layout.
+
+#define SNAP_MAGIC "OMSNAP1"
+#define SNAP_IMAGE_MAGIC "OMBTIMG"
+#define SNAP_BUFFER (1 << 20)
+
+enum SnapKind { SNAP_BST, SNAP_AVL, SNAP_SPLAY, SNAP_BTREE, SNAP_BTREE_IMAGE };
+
+struct SnapHeader {
+    char magic[8];
+    uint32_t kind;        // enum SnapKind of the tree that was saved
+    uint32_t keySize;
+    uint32_t valSize;
+    uint32_t pageSize;    // image only
+    uint64_t count;       // entries
+    uint64_t pages;       // image only
+    uint64_t checksum;
+    uint32_t height;      // image only
+    uint32_t btreeT;      // image only: OM_BTREE_T of the writer
+    char pad[8];
+};
+
+// Word-at-a-time 64-bit hash, applied record by record on save and load
+static inline uint64_t snapChecksum(uint64_t h, const void *data, size_t len) {
+    const unsigned char *p = (const unsigned char *)data;
+    while (len >= 8) {
+        uint64_t w;
+        memcpy(&w, p, 8);
+        h = (h ^ w) * 0xFF51AFD7ED558CCDULL;
+        h ^= h >> 29;
+        p += 8;
+        len -= 8;
+    }
+    while (len--) {
+        h = (h ^ *p++) * 0x100000001B3ULL;
+    }
+    return h;
+}
+
+// ---------- buffered I/O ----------
+
+struct SnapWriter {
+    int fd;
+    int error;
+    size_t used;
+    uint64_t checksum;
+    unsigned char *buf;
+};
+
+static inline int snapWriteAll(int fd, const void *data, size_t len) {
+    const char *p = (const char *)data;
+    while (len > 0) {
+        ssize_t w = write(fd, p, len);
+        if (w <= 0)
+            return -1;
+        p += w;
+        len -= (size_t)w;
+    }
+    return 0;
+}
+
+static inline int snapReadAll(int fd, void *data, size_t len) {
+    char *p = (char *)data;
+    while (len > 0) {
+        ssize_t r = read(fd, p, len);
+        if (r <= 0)
+            return -1;
+        p += r;
+        len -= (size_t)r;
+    }
+    return 0;
+}
+
+static inline void snapWriterInit(struct SnapWriter *w, int fd) {
+    w->fd = fd;
+    w->error = 0;
+    w->used = 0;
+    w->checksum = 0;
+    w->buf = (unsigned char *)malloc(SNAP_BUFFER);
+    if (w->buf == NULL)
+        w->error = 1;
+}
+
+static inline void snapFlush(struct SnapWriter *w) {
+    if (!w->error && w->used && snapWriteAll(w->fd, w->buf, w->used) != 0)
+        w->error = 1;
+    w->used = 0;
+}
+
+static inline void snapPut(struct SnapWriter *w, const void *data, size_t len) {
+    if (w->error)
+        return;
+    w->checksum = snapChecksum(w->checksum, data, len);
+    if (w->used + len > SNAP_BUFFER)
+        snapFlush(w);
+    memcpy(w->buf + w->used, data, len);
+    w->used += len;
+}
+
+// Flushes, then writes the header at offset 0 (space for it was skipped)
+static inline int snapWriterFinish(struct SnapWriter *w, struct SnapHeader *h) {
+    snapFlush(w);
+    free(w->buf);
+    h->checksum = w->checksum;
+    if (w->error || pwrite(w->fd, h, sizeof(*h), 0) != (ssize_t)sizeof(*h))
+        return -1;
+    return 0;
+}
+
+static inline void snapHeaderInit(struct SnapHeader *h, const char *magic, enum SnapKind kind, uint64_t count) {
+    memset(h, 0, sizeof(*h));
+    memcpy(h->magic, magic, 8);
+    h->kind = kind;
+    h->keySize = sizeof(OM_KEY_T);
+    h->valSize = sizeof(OM_VAL_T);
+    h->count = count;
+}
+
+// ---------- entry snapshots ----------
+
+static inline int snapSaveVisit(OM_KEY_T key, OM_VAL_T *val, void *ctx) {
+    struct SnapWriter *w = (struct SnapWriter *)ctx;
+    snapPut(w, &key, sizeof(key));
+    snapPut(w, val, sizeof(*val));
+    return w->error;
+}
+
+// Reads a snapshot's entries into keys[]/vals[] (allocated here). Keys
+// must be strictly increasing, as the builders assume; a file with keys
+// out of order or repeated is refused even if its checksum matches.
+static inline int snapReadEntries(int fd, uint64_t *count, OM_KEY_T **keys, OM_VAL_T **vals) {
+    struct SnapHeader h;
+    if (lseek(fd, 0, SEEK_SET) < 0 || snapReadAll(fd, &h, sizeof(h)) != 0)
+        return -1;
+    if (memcmp(h.magic, SNAP_MAGIC, 8) != 0 || h.keySize != sizeof(OM_KEY_T) ||
+        h.valSize != sizeof(OM_VAL_T))
+        return -1;
+    // the count comes from the file: it must fit in the bytes after the header
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (uint64_t)st.st_size < sizeof(h) ||
+        h.count > ((uint64_t)st.st_size - sizeof(h)) / (sizeof(OM_KEY_T) + sizeof(OM_VAL_T)))
+        return -1;
+    OM_KEY_T *k = (OM_KEY_T *)malloc(sizeof(OM_KEY_T) * (h.count ? h.count : 1));
+    OM_VAL_T *v = (OM_VAL_T *)malloc(sizeof(OM_VAL_T) * (h.count ? h.count : 1));
+    unsigned char *buf = (unsigned char *)malloc(SNAP_BUFFER);
+    size_t record = sizeof(OM_KEY_T) + sizeof(OM_VAL_T);
+    size_t perChunk = SNAP_BUFFER / record;
+    uint64_t sum = 0;
+    int ok = k && v && buf;
+    for (uint64_t i = 0; ok && i < h.count;) {
+        size_t batch = h.count - i < perChunk ? (size_t)(h.count - i) : perChunk;
+        if (snapReadAll(fd, buf, batch * record) != 0) {
+            ok = 0;
+            break;
+        }
+        for (size_t j = 0; j < batch; j++, i++) {
+            const unsigned char *p = buf + j * record;
+            memcpy(&k[i], p, sizeof(OM_KEY_T));
+            memcpy(&v[i], p + sizeof(OM_KEY_T), sizeof(OM_VAL_T));
+            if (i > 0 && !OM_LESS(k[i - 1], k[i]))
+                ok = 0;
+            sum = snapChecksum(sum, &k[i], sizeof(OM_KEY_T));
+            sum = snapChecksum(sum, &v[i], sizeof(OM_VAL_T));
+        }
+    }
+    free(buf);
+    if (!ok || sum != h.checksum) {
+        free(k);
+        free(v);
+        return -1;
+    }
+    *count = h.count;
+    *keys = k;
+    *vals = v;
+    return 0;
+}
+
+// ---------- O(n) builders from sorted entries ----------
+
+static inline struct AvlNode *avlBuildSorted(const OM_KEY_T *keys, const OM_VAL_T *vals, int64_t lo, int64_t hi) {
+    if (lo > hi)
+        return NULL;
+    int64_t mid = lo + (hi - lo) / 2;
+    struct AvlNode *n = (struct AvlNode *)OM_MALLOC(sizeof(struct AvlNode));
+    n->key = keys[mid];
+    n->val = vals[mid];
+    n->left = avlBuildSorted(keys, vals, lo, mid - 1);
+    n->right = avlBuildSorted(keys, vals, mid + 1, hi);
+    avlUpdate(n);
+    return n;
+}
+
+static inline struct SplayNode *splayBuildSorted(const OM_KEY_T *keys, const OM_VAL_T *vals, int64_t lo, int64_t hi,
+                                                 struct SplayNode *parent) {
+    if (lo > hi)
+        return NULL;
+    int64_t mid = lo + (hi - lo) / 2;
+    struct SplayNode *n = (struct SplayNode *)OM_MALLOC(sizeof(struct SplayNode));
+    n->key = keys[mid];
+    n->val = vals[mid];
+    n->parent = parent;
+    n->left = splayBuildSorted(keys, vals, lo, mid - 1, n);
+    n->right = splayBuildSorted(keys, vals, mid + 1, hi, n);
+    return n;
+}
+
+// Minimum-height B-tree over n sorted entries. A subtree of height h
+// holds at most (2T)^h - 1 entries; splitting n+1 evenly over
+// ceil((n+1) / (2T)^(h-1)) children keeps every non-root node at least
+// half full (T-1 keys), so the result is a valid B-tree.
+static inline struct BTreeNode *btreeBuildSorted(const OM_KEY_T *keys, const OM_VAL_T *vals, uint64_t n, int h,
+                                                 const uint64_t *capacity) {
+    struct BTreeNode *x = btreeNewNode(h == 1);
+    if (h == 1) {
+        x->count = (int)n;
+        for (uint64_t i = 0; i < n; i++) {
+            x->keys[i] = keys[i];
+            x->vals[i] = vals[i];
+        }
+        return x;
+    }
+    uint64_t c = (n + 1 + capacity[h - 1]) / (capacity[h - 1] + 1);   // children
+    uint64_t base = (n + 1) / c, extra = (n + 1) % c, pos = 0;
+    for (uint64_t i = 0; i < c; i++) {
+        uint64_t size = base + (i < extra) - 1;
+        btreeChild(x)[i] = btreeBuildSorted(keys + pos, vals + pos, size, h - 1, capacity);
+        pos += size;
+        if (i + 1 < c) {
+            x->keys[i] = keys[pos];
+            x->vals[i] = vals[pos];
+            pos++;
+        }
+    }
+    x->count = (int)(c - 1);
+    return x;
+}
+
+static inline void btreeLoadSorted(struct BTreeMap *m, const OM_KEY_T *keys, const OM_VAL_T *vals, uint64_t n) {
+    uint64_t capacity[64];   // capacity[h] = (2T)^h - 1, saturating
+    capacity[0] = 0;
+    int h = 0;
+    while (capacity[h] < n) {
+        h++;
+        capacity[h] = capacity[h - 1] > UINT64_MAX / (2 * OM_BTREE_T)
+                          ? UINT64_MAX
+                          : (capacity[h - 1] + 1) * (2 * OM_BTREE_T) - 1;
+    }
+    m->size = n;
+    m->height = h;
+    m->root = n ? btreeBuildSorted(keys, vals, n, h, capacity) : NULL;
+}
+
+// ---------- save/load per tree ----------
+
+static inline int snapSaveEntries(int fd, enum SnapKind kind, uint64_t count,
+                                  size_t (*scan)(void *, OmVisit, void *), void *map) {
+    struct SnapHeader h;
+    struct SnapWriter w;
+    snapHeaderInit(&h, SNAP_MAGIC, kind, count);
+    if (lseek(fd, sizeof(h), SEEK_SET) < 0)
+        return -1;
+    snapWriterInit(&w, fd);
+    scan(map, snapSaveVisit, &w);
+    return snapWriterFinish(&w, &h);
+}
+
+// Whole-map scans start from the leftmost key, so nothing is assumed
+// about the smallest value of OM_KEY_T
+#define SNAP_DEFINE_SCAN_ALL(x, MapType, NodeType)                                       \
+    static inline size_t x##ScanAll(void *map, OmVisit visit, void *ctx) {               \
+        struct MapType *m = (struct MapType *)map;                                       \
+        NodeType *n = m->root;                                                           \
+        if (n == NULL)                                                                   \
+            return 0;                                                                    \
+        while (n->left)                                                                  \
+            n = n->left;                                                                 \
+        return x##MapScan(m, n->key, SIZE_MAX, visit, ctx);                              \
+    }
+
+SNAP_DEFINE_SCAN_ALL(avl, AvlMap, struct AvlNode)
+SNAP_DEFINE_SCAN_ALL(splay, SplayMap, struct SplayNode)
+
+static inline size_t btreeScanAll(void *map, OmVisit visit, void *ctx) {
+    struct BTreeMap *m = (struct BTreeMap *)map;
+    struct BTreeNode *x = m->root;
+    if (x == NULL)
+        return 0;
+    while (!x->leaf)
+        x = btreeChild(x)[0];
+    return btreeMapScan(m, x->keys[0], SIZE_MAX, visit, ctx);
+}
+
+static inline int avlMapSave(struct AvlMap *m, int fd) {
+    return snapSaveEntries(fd, SNAP_AVL, m->size, avlScanAll, m);
+}
+
+static inline int splayMapSave(struct SplayMap *m, int fd) {
+    return snapSaveEntries(fd, SNAP_SPLAY, m->size, splayScanAll, m);
+}
+
+static inline int btreeMapSave(struct BTreeMap *m, int fd) {
+    return snapSaveEntries(fd, SNAP_BTREE, m->size, btreeScanAll, m);
+}
+
+static inline int avlMapLoad(struct AvlMap *m, int fd) {
+    uint64_t n;
+    OM_KEY_T *keys;
+    OM_VAL_T *vals;
+    if (snapReadEntries(fd, &n, &keys, &vals) != 0)
+        return -1;
+    m->root = avlBuildSorted(keys, vals, 0, (int64_t)n - 1);
+    m->size = n;
+    free(keys);
+    free(vals);
+    return 0;
+}
+
+static inline int splayMapLoad(struct SplayMap *m, int fd) {
+    uint64_t n;
+    OM_KEY_T *keys;
+    OM_VAL_T *vals;
+    if (snapReadEntries(fd, &n, &keys, &vals) != 0)
+        return -1;
+    m->root = splayBuildSorted(keys, vals, 0, (int64_t)n - 1, NULL);
+    m->size = n;
+    free(keys);
+    free(vals);
+    return 0;
+}
+
+static inline int btreeMapLoad(struct BTreeMap *m, int fd) {
+    uint64_t n;
+    OM_KEY_T *keys;
+    OM_VAL_T *vals;
+    if (snapReadEntries(fd, &n, &keys, &vals) != 0)
+        return -1;
+    btreeLoadSorted(m, keys, vals, n);
+    free(keys);
+    free(vals);
+    return 0;
+}
+
+// ---------- B-tree page image ----------
+
+struct BTreePage {
+    uint32_t count;
+    uint32_t leaf;
+    uint64_t child[OM_BTREE_MAX + 1];   // page numbers; unused in leaves
+    OM_KEY_T keys[OM_BTREE_MAX];
+    OM_VAL_T vals[OM_BTREE_MAX];
+};
+
+struct BTreeImage {
+    void *base;
+    size_t length;
+    const struct SnapHeader *header;
+    const struct BTreePage *pages;
+};
+
+static inline int btreeMapSaveImage(struct BTreeMap *m, int fd) {
+    struct SnapHeader h;
+    struct SnapWriter w;
+    struct BTreePage *page = (struct BTreePage *)calloc(1, sizeof(struct BTreePage));
+    // level order: pages are numbered in the order they are queued
+    size_t queueCap = 1024, head = 0, tail = 0;
+    struct BTreeNode **queue = (struct BTreeNode **)malloc(sizeof(struct BTreeNode *) * queueCap);
+    snapHeaderInit(&h, SNAP_IMAGE_MAGIC, SNAP_BTREE_IMAGE, m->size);
+    h.pageSize = sizeof(struct BTreePage);
+    h.height = (uint32_t)m->height;
+    h.btreeT = OM_BTREE_T;
+    if (page == NULL || queue == NULL || lseek(fd, sizeof(h), SEEK_SET) < 0) {
+        free(page);
+        free(queue);
+        return -1;
+    }
+    snapWriterInit(&w, fd);
+    if (m->root)
+        queue[tail++] = m->root;
+    while (head < tail) {
+        struct BTreeNode *x = queue[head++];
+        memset(page, 0, sizeof(*page));   // no uninitialised bytes in the file or checksum
+        page->count = (uint32_t)x->count;
+        page->leaf = (uint32_t)x->leaf;
+        for (int i = 0; i < x->count; i++) {
+            page->keys[i] = x->keys[i];
+            page->vals[i] = x->vals[i];
+        }
+        if (!x->leaf) {
+            for (int i = 0; i <= x->count; i++) {
+                if (tail == queueCap) {
+                    queueCap *= 2;
+                    queue = (struct BTreeNode **)realloc(queue, sizeof(struct BTreeNode *) * queueCap);
+                }
+                page->child[i] = tail;
+                queue[tail++] = btreeChild(x)[i];
+            }
+        }
+        snapPut(&w, page, sizeof(*page));
+    }
+    h.pages = tail;
+    free(queue);
+    free(page);
+    return snapWriterFinish(&w, &h);
+}
+
+// Page i of an image is well formed: its keys fit, and its children come
+// later in level order and exist, so searches always end at a leaf
+static inline int btreeImagePageOk(const struct BTreePage *pages, uint64_t npages, uint64_t i) {
+    const struct BTreePage *p = &pages[i];
+    if (p->count > OM_BTREE_MAX || p->leaf > 1)
+        return 0;
+    for (uint32_t j = 0; !p->leaf && j <= p->count; j++)
+        if (p->child[j] <= i || p->child[j] >= npages)
+            return 0;
+    return 1;
+}
+
+// Maps an image read-only after checking its header. With verify set,
+// every page and the checksum over all of them are checked as well.
+static inline int btreeImageOpen(struct BTreeImage *img, int fd, int verify) {
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(struct SnapHeader))
+        return -1;
+    void *base = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    if (base == MAP_FAILED)
+        return -1;
+    const struct SnapHeader *h = (const struct SnapHeader *)base;
+    int ok = memcmp(h->magic, SNAP_IMAGE_MAGIC, 8) == 0 && h->keySize == sizeof(OM_KEY_T) &&
+             h->valSize == sizeof(OM_VAL_T) && h->pageSize == sizeof(struct BTreePage) &&
+             h->pages <= ((size_t)st.st_size - sizeof(*h)) / sizeof(struct BTreePage);
+    const struct BTreePage *pages = (const struct BTreePage *)((const char *)base + sizeof(*h));
+    if (ok && verify) {
+        uint64_t sum = 0;
+        for (uint64_t i = 0; ok && i < h->pages; i++) {
+            ok = btreeImagePageOk(pages, h->pages, i);
+            sum = snapChecksum(sum, &pages[i], sizeof(struct BTreePage));
+        }
+        ok = ok && sum == h->checksum;
+    }
+    if (!ok) {
+        munmap(base, (size_t)st.st_size);
+        return -1;
+    }
+    img->base = base;
+    img->length = (size_t)st.st_size;
+    img->header = h;
+    img->pages = pages;
+    return 0;
+}
+
+// Searches the mapped pages; a malformed page on the path reads as not found
+static inline const OM_VAL_T *btreeImageFind(const struct BTreeImage *img, OM_KEY_T key) {
+    uint64_t npages = img->header->pages, i = 0;
+    if (npages == 0)
+        return NULL;
+    for (;;) {
+        if (!btreeImagePageOk(img->pages, npages, i))
+            return NULL;
+        const struct BTreePage *p = &img->pages[i];
+        uint32_t lo = 0, hi = p->count;
+        while (lo < hi) {
+            uint32_t mid = (lo + hi) >> 1;
+            if (OM_LESS(p->keys[mid], key))
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        if (lo < p->count && !OM_LESS(key, p->keys[lo]))
+            return &p->vals[lo];
+        if (p->leaf)
+            return NULL;
+        i = p->child[lo];
+    }
+}
+
+static inline void btreeImageClose(struct BTreeImage *img) {
+    munmap(img->base, img->length);
+    img->base = NULL;
+}
+
+#endif
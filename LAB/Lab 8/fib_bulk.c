@@ -0,0 +1,130 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "fib_heap.h"
+
+/*
+ Bulk loading benchmark for fib_heap.h
+ - insert:  heap_insert() once per key (n splices, n min compares)
+ - batch:   heap_insert_batch() into an existing heap, with handles
+ - build:   heap_build() from the array
+ - meld:    <parts> heaps built separately and melded into the first
+            in place, vs inserting the keys of parts 2.. into the first
+            one by one
+ After each load the first extract-min (which consolidates all n
+ singleton roots) is timed too, and the first extracted keys are
+ compared with the sorted input.
+ Compile:
+   gcc -O2 -o fib_bulk fib_bulk.c -lm
+ Run:
+   ./fib_bulk [events] [parts]
+*/
+
+static unsigned long long rng_state = 88172645463325252ULL;
+
+static unsigned long long rng_next(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return rng_state;
+}
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static int cmp_int(const void *a, const void *b) {
+    int x = *(const int*) a, y = *(const int*) b;
+    return x < y ? -1 : x > y;
+}
+
+/* time the first extract-min, then check the next mins against sorted keys */
+static int check(FibHeap *H, const int *sorted, int n, int checked, double *t_first) {
+    int ok = H->n == n;
+    double t0 = now_sec();
+    for (int i = 0; i < checked && ok; ++i) {
+        FibNode *m = extract_min(H);
+        if (i == 0) *t_first = now_sec() - t0;
+        ok = m != NULL && m->key == sorted[i];
+        free_node(H, m);
+    }
+    return ok;
+}
+
+static void report(const char *label, double t_load, int n, double t_first, int ok) {
+    printf("%-22s %10.6f %10.1f %14.6f  %s\n", label, t_load, n / t_load / 1e6, t_first,
+           ok ? "OK" : "FAILED");
+}
+
+int main(int argc, char **argv) {
+    int n = argc > 1 ? (int) atof(argv[1]) : 4000000;
+    int parts = argc > 2 ? atoi(argv[2]) : 64;
+    if (n < 1) n = 1;
+    if (parts < 1) parts = 1;
+    if (parts > n) parts = n;
+    int checked = n < 100000 ? n : 100000;
+
+    int *keys = (int*) malloc(n * sizeof(int));
+    int *sorted = (int*) malloc(n * sizeof(int));
+    for (int i = 0; i < n; ++i) keys[i] = sorted[i] = (int) (rng_next() % 1000000000);
+    qsort(sorted, n, sizeof(int), cmp_int);
+    FibNode **handles = (FibNode**) malloc(n * sizeof(FibNode*));
+    double t0, t_load, t_first = 0;
+
+    printf("%d events\n", n);
+    printf("%-22s %10s %10s %14s\n", "load", "time s", "Mkeys/s", "1st extract s");
+
+    FibHeap *H = create_heap();
+    t0 = now_sec();
+    for (int i = 0; i < n; ++i) heap_insert(H, keys[i]);
+    t_load = now_sec() - t0;
+    int ok = check(H, sorted, n, checked, &t_first);
+    report("heap_insert loop", t_load, n, t_first, ok);
+    free_heap(H);
+
+    H = create_heap();
+    t0 = now_sec();
+    heap_insert_batch(H, keys, n, handles);
+    t_load = now_sec() - t0;
+    ok = handles[n - 1]->key == keys[n - 1] && check(H, sorted, n, checked, &t_first);
+    report("heap_insert_batch", t_load, n, t_first, ok);
+    free_heap(H);
+
+    t0 = now_sec();
+    H = heap_build(keys, n);
+    t_load = now_sec() - t0;
+    ok = check(H, sorted, n, checked, &t_first);
+    report("heap_build", t_load, n, t_first, ok);
+    free_heap(H);
+
+    /* parts built separately, then combined */
+    FibHeap **P = (FibHeap**) malloc(parts * sizeof(FibHeap*));
+    for (int p = 0; p < parts; ++p) {
+        int lo = (int) ((long) n * p / parts), hi = (int) ((long) n * (p + 1) / parts);
+        P[p] = heap_build(keys + lo, hi - lo);
+    }
+    t0 = now_sec();
+    for (int p = 1; p < parts; ++p) meld(P[0], P[p]);
+    t_load = now_sec() - t0;
+    ok = check(P[0], sorted, n, checked, &t_first);
+    report("meld parts", t_load, n, t_first, ok);
+    for (int p = 0; p < parts; ++p) free_heap(P[p]);
+
+    /* without meld: insert the keys of the other parts into the first */
+    int first_hi = (int) ((long) n / parts);
+    H = heap_build(keys, first_hi);
+    t0 = now_sec();
+    for (int i = first_hi; i < n; ++i) heap_insert(H, keys[i]);
+    t_load = now_sec() - t0;
+    ok = check(H, sorted, n, checked, &t_first);
+    report("re-insert parts", t_load, n, t_first, ok);
+    free_heap(H);
+
+    free(P);
+    free(handles);
+    free(keys);
+    free(sorted);
+    return 0;
+}
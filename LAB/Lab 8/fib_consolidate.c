@@ -0,0 +1,233 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+
+/* keys are (priority << 20) | id, so there are no ties and both versions
+   extract the same sequence */
+#define FIB_KEY_T long long
+#define FIB_KEY_FMT "%lld"
+#define ID_BITS 20
+#include "fib_heap.h"
+
+/*
+ Extract-min latency: legacy consolidate vs the degree-table fast path
+ - legacy: the consolidate()/extract_min() fib_heap.h had before, copied
+   here: log() and calloc() per call, a counting walk over the roots,
+   children spliced into the root list first, root list rebuilt by
+   scanning the whole array.
+ - current: extract_min() of fib_heap.h (reused degree table, one walk
+   over roots and children, rebuild only up to the highest degree).
+ Both run the same trace on a heap of <n> nodes: every round is one
+ extract-min, one re-insert and a few decrease-keys. Each extract-min is
+ timed and the latency distribution is printed; the extracted key sums
+ must agree (keys carry the id in their low bits, so there are no ties). A final teardown of a heap degenerated into one path of
+ depth n checks that free_nodes no longer recurses on the shape.
+ Compile:
+   gcc -O2 -o fib_consolidate fib_consolidate.c -lm
+ Run:
+   ./fib_consolidate [nodes] [rounds]
+*/
+
+/* ---------- legacy version ---------- */
+
+static void legacy_link(FibNode *y, FibNode *x) {
+    /* remove y from root list */
+    y->left->right = y->right;
+    y->right->left = y->left;
+    /* make y a child of x */
+    y->parent = x;
+    if (x->child == NULL) {
+        x->child = y;
+        y->right = y;
+        y->left = y;
+    } else {
+        y->right = x->child->right;
+        y->left = x->child;
+        x->child->right->left = y;
+        x->child->right = y;
+    }
+    x->degree++;
+    y->mark = 0;
+}
+
+static void legacy_consolidate(FibHeap *H) {
+    if (H->min == NULL) return;
+
+    int maxDegree = (int) (log(H->n) / log(2)) + 5; /* safe upper bound */
+    FibNode **A = (FibNode**) calloc(maxDegree, sizeof(FibNode*));
+    for (int i = 0; i < maxDegree; ++i) A[i] = NULL;
+
+    int rootsCount = 0;
+    FibNode *w = H->min;
+    if (w != NULL) {
+        rootsCount = 1;
+        w = w->right;
+        while (w != H->min) {
+            rootsCount++;
+            w = w->right;
+        }
+    }
+
+    FibNode *x = H->min;
+    for (int i = 0; i < rootsCount; ++i) {
+        FibNode *next = x->right;
+        int d = x->degree;
+        while (d >= maxDegree) {
+            int old = maxDegree;
+            maxDegree *= 2;
+            A = (FibNode**) realloc(A, maxDegree * sizeof(FibNode*));
+            for (int j = old; j < maxDegree; ++j) A[j] = NULL;
+        }
+        while (A[d] != NULL) {
+            FibNode *y = A[d];
+            if (x->key > y->key) {
+                FibNode *tmp = x; x = y; y = tmp;
+            }
+            legacy_link(y, x);
+            A[d] = NULL;
+            d = x->degree;
+        }
+        A[d] = x;
+        x = next;
+    }
+
+    H->min = NULL;
+    for (int i = 0; i < maxDegree; ++i) {
+        if (A[i] != NULL) {
+            A[i]->left = A[i];
+            A[i]->right = A[i];
+            A[i]->parent = NULL;
+            if (H->min == NULL) {
+                H->min = A[i];
+            } else {
+                A[i]->right = H->min->right;
+                A[i]->left = H->min;
+                H->min->right->left = A[i];
+                H->min->right = A[i];
+                if (A[i]->key < H->min->key) H->min = A[i];
+            }
+        }
+    }
+
+    free(A);
+}
+
+static FibNode* legacy_extract_min(FibHeap *H) {
+    FibNode *z = H->min;
+    if (z != NULL) {
+        FibNode *child = z->child;
+        if (child != NULL) {
+            FibNode *start = child;
+            FibNode *cur = start;
+            do {
+                FibNode *next = cur->right;
+                cur->parent = NULL;
+                cur->left = H->min;
+                cur->right = H->min->right;
+                H->min->right->left = cur;
+                H->min->right = cur;
+                cur = next;
+            } while (cur != start);
+        }
+        z->left->right = z->right;
+        z->right->left = z->left;
+        if (z == z->right) {
+            H->min = NULL;
+        } else {
+            H->min = z->right;
+            legacy_consolidate(H);
+        }
+        H->n--;
+        if (z->id >= 0) H->index[z->id] = NULL;
+    }
+    return z;
+}
+
+/* ---------- benchmark ---------- */
+
+static unsigned long long rng_state;
+
+static unsigned long long rng_next(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return rng_state;
+}
+
+static long long now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+static int cmp_ll(const void *a, const void *b) {
+    long long x = *(const long long*) a, y = *(const long long*) b;
+    return x < y ? -1 : x > y;
+}
+
+static void run(const char *label, int legacy, int n, int rounds, long long *lat) {
+    rng_state = 88172645463325252ULL;
+    FibHeap *H = create_heap();
+    for (int i = 0; i < n; ++i)
+        heap_insert_id(H, i, (long long) (rng_next() % 100000000) << ID_BITS | i);
+
+    long long checksum = 0, total = 0;
+    for (int r = 0; r < rounds; ++r) {
+        long long t0 = now_ns();
+        FibNode *m = legacy ? legacy_extract_min(H) : extract_min(H);
+        lat[r] = now_ns() - t0;
+        total += lat[r];
+        int id = m->id;
+        checksum += m->key >> ID_BITS;
+        heap_insert_id(H, id, m->key + ((long long) (rng_next() % 1000000) << ID_BITS));
+        free_node(H, m);
+        for (int j = 0; j < 4; ++j) {
+            FibNode *x = heap_node(H, (int) (rng_next() % (unsigned) n));
+            decrease_key(H, x, x->key - ((long long) (rng_next() % 10000) << ID_BITS));
+        }
+    }
+    free_heap(H);
+
+    qsort(lat, rounds, sizeof(long long), cmp_ll);
+    printf("%-8s %9.0f %8lld %8lld %8lld %8lld %9lld %16lld\n", label, (double) total / rounds,
+           lat[rounds / 2], lat[(int) (rounds * 0.9)], lat[(int) (rounds * 0.99)],
+           lat[(int) (rounds * 0.999)], lat[rounds - 1], checksum);
+}
+
+int main(int argc, char **argv) {
+    int n = argc > 1 ? atoi(argv[1]) : 1000000;
+    if (n > (1 << ID_BITS)) n = 1 << ID_BITS;
+    int rounds = argc > 2 ? atoi(argv[2]) : 1000000;
+    if (n < 1) n = 1;
+    if (rounds < 1) rounds = 1;
+    long long *lat = (long long*) malloc(rounds * sizeof(long long));
+
+    printf("extract-min latency (ns), heap of %d nodes, %d rounds\n", n, rounds);
+    printf("%-8s %9s %8s %8s %8s %8s %9s %16s\n", "version", "mean", "p50", "p90", "p99",
+           "p99.9", "max", "checksum");
+    /* the first extract-min consolidates all n singletons; it is the max */
+    run("legacy", 1, n, rounds, lat);
+    run("current", 0, n, rounds, lat);
+
+    /* degenerate heap: each round inserts a < b < c below the root, extracts
+       a (b adopts c, then the old chain) and deletes c, so the single tree
+       becomes a path one node longer; then tear it down in malloc mode */
+    FibHeap *H = create_heap_slab(0);
+    heap_insert(H, 0);
+    for (int i = 0; i < n; ++i) {
+        heap_insert(H, -3 * i - 3);
+        heap_insert(H, -3 * i - 2);
+        FibNode *c = heap_insert(H, -3 * i - 1);
+        free_node(H, extract_min(H));
+        heap_delete(H, c);
+    }
+    int depth = 0;
+    for (FibNode *x = H->min; x != NULL; x = x->child) depth++;
+    long long t0 = now_ns();
+    free_heap(H);
+    printf("teardown of a %d-node heap of depth %d: %.3f ms\n", n + 1, depth, (now_ns() - t0) / 1e6);
+
+    free(lat);
+    return 0;
+}
@@ -0,0 +1,150 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <limits.h>
+#include "fib_heap.h"
+
+/*
+ Decrease-key benchmark for fib_heap.h: id/handle lookup vs search
+ - handle path: decrease_key_id() finds the node through the id index
+   in O(1), so decrease-key costs only its O(1) amortized cut work.
+ - search path: find_node() by key (the old menu behaviour), which
+   walks the heap, then decrease_key().
+ Both paths run the same decreases on two identical heaps, which are
+ then drained and compared. A longer run of handle-only decreases mixed
+ with extract-min checks that the heap still drains in sorted order.
+ Compile:
+   gcc -O2 -o fib_decrease_key fib_decrease_key.c -lm
+ Run:
+   ./fib_decrease_key [nodes] [search_decreases]
+*/
+
+static unsigned long long rng_state = 88172645463325252ULL;
+
+static unsigned long long rng_next(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return rng_state;
+}
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void shuffle(int *a, int n) {
+    for (int i = n - 1; i > 0; --i) {
+        int j = (int) (rng_next() % (unsigned) (i + 1));
+        int t = a[i]; a[i] = a[j]; a[j] = t;
+    }
+}
+
+/* ids 0..n-1 with distinct keys 4*perm[id] + 2, so find_node() by key is exact */
+static FibHeap* build_heap(const int *perm, int n) {
+    FibHeap *H = create_heap();
+    for (int i = 0; i < n; ++i) heap_insert_id(H, i, 4 * perm[i] + 2);
+    free_node(H, extract_min(H)); /* consolidate into trees, as in real use */
+    return H;
+}
+
+/* extract everything; 1 if keys come out in nondecreasing order */
+static int drain_sorted(FibHeap *H, long *count) {
+    int ok = 1, prev = INT_MIN;
+    *count = 0;
+    FibNode *m;
+    while ((m = extract_min(H)) != NULL) {
+        if (m->key < prev) ok = 0;
+        prev = m->key;
+        (*count)++;
+        free_node(H, m);
+    }
+    return ok;
+}
+
+int main(int argc, char **argv) {
+    int n = argc > 1 ? atoi(argv[1]) : 1000000;
+    int searches = argc > 2 ? atoi(argv[2]) : 200;
+    if (n < 2) n = 2;
+    if (searches > n - 1) searches = n - 1;
+
+    int *perm = (int*) malloc(n * sizeof(int));
+    int *order = (int*) malloc(n * sizeof(int));
+    for (int i = 0; i < n; ++i) perm[i] = order[i] = i;
+    shuffle(perm, n);
+    shuffle(order, n);
+
+    double t0 = now_sec();
+    FibHeap *A = build_heap(perm, n);
+    double t_build = now_sec() - t0;
+    FibHeap *B = build_heap(perm, n);
+
+    /* distinct ids still in the heap; key k becomes k - 1, which stays distinct */
+    int *ids = (int*) malloc(searches * sizeof(int));
+    int *keys = (int*) malloc(searches * sizeof(int));
+    for (int i = 0, j = 0; i < searches; ++j) {
+        FibNode *x = heap_node(A, order[j]);
+        if (x == NULL) continue; /* the extracted minimum */
+        ids[i] = order[j];
+        keys[i++] = x->key;
+    }
+
+    t0 = now_sec();
+    for (int i = 0; i < searches; ++i) decrease_key_id(A, ids[i], keys[i] - 1);
+    double t_handle = now_sec() - t0;
+
+    t0 = now_sec();
+    for (int i = 0; i < searches; ++i) {
+        FibNode *x = find_node(B, keys[i]);
+        if (x) decrease_key(B, x, keys[i] - 1);
+    }
+    double t_search = now_sec() - t0;
+
+    int same = 1;
+    while (same && A->min != NULL) {
+        FibNode *a = extract_min(A), *b = extract_min(B);
+        same = b != NULL && a->key == b->key && a->id == b->id;
+        free_node(A, a);
+        free_node(B, b);
+    }
+    same = same && B->min == NULL;
+
+    /* long run: handle decreases interleaved with extract-min */
+    FibHeap *C = build_heap(perm, n);
+    long decreases = 0, extracts = 0;
+    t0 = now_sec();
+    for (int i = 0; i < n; ++i) {
+        int id = (int) (rng_next() % (unsigned) n);
+        FibNode *x = heap_node(C, id);
+        if (x != NULL) {
+            decrease_key(C, x, x->key - (int) (rng_next() % 1000));
+            decreases++;
+        }
+        if (i % 8 == 7) {
+            free_node(C, extract_min(C));
+            extracts++;
+        }
+    }
+    double t_mixed = now_sec() - t0;
+    long left;
+    int sorted = drain_sorted(C, &left);
+
+    printf("%d nodes, build %.3f s\n", n, t_build);
+    printf("%d decreases: by id %.3f us/op, find_node + decrease %.1f us/op, speedup %.0fx\n",
+           searches, t_handle / searches * 1e6, t_search / searches * 1e6,
+           t_search / (t_handle > 0 ? t_handle : 1e-9));
+    printf("mixed run: %ld decreases by id + %ld extract-min in %.3f s (%.0f ns/op)\n",
+           decreases, extracts, t_mixed, t_mixed / (decreases + extracts) * 1e9);
+    printf("same drain order on both heaps: %s, sorted drain of %ld after mixed run: %s\n",
+           same ? "OK" : "FAILED", left, sorted && left == n - 1 - extracts ? "OK" : "FAILED");
+
+    free_heap(A);
+    free_heap(B);
+    free_heap(C);
+    free(ids);
+    free(keys);
+    free(perm);
+    free(order);
+    return 0;
+}
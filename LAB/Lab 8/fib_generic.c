@@ -0,0 +1,129 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/*
+ fib_heap.h instantiated with double priorities and an int payload
+ - demo: a small deadline scheduler; each node carries the task number
+   and tasks are rescheduled and cancelled through their handles.
+ - check: random inserts, decrease-keys and deletes on <n> nodes; the
+   heap is drained and compared with a sorted copy of the live keys,
+   and every payload must still belong to its key.
+ Other key types work the same way, e.g. int64_t priorities:
+   #define FIB_KEY_T int64_t
+   #define FIB_KEY_FMT "%" PRId64
+ Compile:
+   gcc -O2 -o fib_generic fib_generic.c -lm
+ Run:
+   ./fib_generic [n]
+*/
+
+#define FIB_KEY_T double
+#define FIB_KEY_FMT "%g"
+#define FIB_DATA_T int
+#include "fib_heap.h"
+
+static unsigned long long rng_state = 88172645463325252ULL;
+
+static unsigned long long rng_next(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return rng_state;
+}
+
+static double rng_double(void) {
+    return (rng_next() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+static int cmp_double(const void *a, const void *b) {
+    double x = *(const double*) a, y = *(const double*) b;
+    return x < y ? -1 : x > y;
+}
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+int main(int argc, char **argv) {
+    int n = argc > 1 ? atoi(argv[1]) : 1000000;
+    if (n < 1) n = 1;
+
+    /* deadline scheduler */
+    const char *names[] = {"backup", "email", "build", "deploy", "report"};
+    double deadlines[] = {12.5, 3.25, 7.0, 9.75, 15.0};
+    FibHeap *S = create_heap();
+    FibNode *task[5];
+    for (int i = 0; i < 5; ++i) task[i] = heap_insert_data(S, deadlines[i], i);
+    print_root_list(S);
+    decrease_key(S, task[3], 1.5); /* deploy became urgent */
+    heap_delete(S, task[0]);       /* backup cancelled */
+    printf("Run order:");
+    FibNode *t;
+    while ((t = extract_min(S)) != NULL) {
+        printf(" %s@%g", names[t->data], t->key);
+        free_node(S, t);
+    }
+    printf("\n");
+    free_heap(S);
+
+    /* randomized check */
+    FibHeap *H = create_heap();
+    FibNode **node = (FibNode**) malloc(n * sizeof(FibNode*));
+    double *key = (double*) malloc(n * sizeof(double));
+    int *alive = (int*) malloc(n * sizeof(int));
+    double t0 = now_sec();
+    for (int i = 0; i < n; ++i) {
+        key[i] = rng_double() * 1e6;
+        node[i] = heap_insert_data(H, key[i], i);
+        alive[i] = 1;
+    }
+    FibNode *first = extract_min(H); /* build some trees first */
+    alive[first->data] = 0;
+    free_node(H, first);
+    int deletes = 0, decreases = 0;
+    for (int i = 0; i < n; ++i) {
+        int j = (int) (rng_next() % (unsigned) n);
+        if (!alive[j]) continue;
+        if (rng_next() % 4 == 0) {
+            heap_delete(H, node[j]);
+            alive[j] = 0;
+            deletes++;
+        } else {
+            key[j] -= rng_double() * 1e3;
+            decrease_key(H, node[j], key[j]);
+            decreases++;
+        }
+    }
+    double t_ops = now_sec() - t0;
+
+    double *live = (double*) malloc(n * sizeof(double));
+    int m = 0;
+    for (int i = 0; i < n; ++i)
+        if (alive[i]) live[m++] = key[i];
+    qsort(live, m, sizeof(double), cmp_double);
+
+    int ok = H->n == m, count = 0;
+    FibNode *x;
+    while ((x = extract_min(H)) != NULL) {
+        ok = ok && x->key == key[x->data] && alive[x->data];
+        ok = ok && count < m && x->key == live[count];
+        alive[x->data] = 0;
+        count++;
+        free_node(H, x);
+    }
+    ok = ok && count == m;
+
+    printf("%d inserts, %d decrease-keys, %d deletes on double keys in %.3f s\n",
+           n, decreases, deletes, t_ops);
+    printf("drain matches sorted keys and payloads: %s\n", ok ? "OK" : "FAILED");
+
+    free_heap(H);
+    free(node);
+    free(key);
+    free(alive);
+    free(live);
+    return 0;
+}
@@ -0,0 +1,838 @@
+#ifndef FIB_HEAP_H
+#define FIB_HEAP_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <limits.h>
+
+/*
+ Fibonacci heap shared by fibonacci.c and the Lab 8 heap benchmarks.
+ Features:
+  - insert, get minimum, extract minimum, union (meld)
+  - in-place meld, batch insert and build from an array
+  - decrease key and delete through node handles
+  - optional id -> node index
+
+ Handles:
+  heap_insert() returns the node, which stays valid (and at the same
+  address) until it is extracted or deleted, so decrease_key() and
+  heap_delete() never search. Callers that name their elements by a
+  small integer id can use heap_insert_id() instead: the heap keeps an
+  id -> node array and decrease_key_id()/delete_id() look the node up
+  in O(1). An extracted or deleted id becomes free again.
+
+ Node pool:
+  Nodes come from slabs of FIB_SLAB_NODES nodes owned by the heap, and
+  nodes given back with free_node() go on a free list that insert
+  reuses first. free_heap() releases the slabs without visiting the
+  nodes. create_heap_slab(0) gives a heap that mallocs every node, as
+  before; extracted nodes must then still go through free_node().
+
+ Bulk loading:
+  heap_insert_batch() takes n contiguous fresh nodes from the pool
+  without going through the free list: the rest of the head slab if it
+  has room, otherwise a dedicated slab of exactly n nodes when n is at
+  least FIB_SLAB_NODES, or else a new head slab (the old head's unused
+  tail then goes on the free list, so nothing is stranded). It chains
+  them in a single pass while tracking their minimum and splices the
+  chain into the root list once. heap_build() does the same into a new
+  heap.
+  meld(H1, H2) moves everything of H2, including its ids and pool, into
+  H1 and leaves H2 a valid empty heap; no header is allocated. It costs
+  O(H2's index capacity) for moving the ids, plus a walk over H2's slab
+  and free lists; the root lists themselves are joined in O(1).
+
+ Consolidation:
+  extract_min hands the remaining roots and the children of the old
+  minimum straight to consolidate, which links them in one walk through
+  a degree table kept in the heap. A tree of degree k has at least
+  F(k+2) nodes, so ceil(log_phi n) + 2 slots are enough; the table only
+  grows with n and is left all NULL after every call. Cascading cuts
+  and free_nodes are loops, so nothing recurses on the heap's shape.
+
+ Key type and payload (define before including, as for ordered_map.h):
+  FIB_KEY_T     priority type (default int)
+  FIB_LESS      strict order on keys (default <)
+  FIB_EQUAL     key equality, used by find_node (default ==)
+  FIB_KEY_FMT   printf format for print_root_list (default "%d")
+  FIB_DATA_T    optional payload stored in every node as node->data
+ e.g. a scheduler with double deadlines and a task pointer:
+  #define FIB_KEY_T double
+  #define FIB_KEY_FMT "%g"
+  #define FIB_DATA_T struct Task*
+  #include "fib_heap.h"
+ Everything is static inline and FIB_LESS is a macro, so the default
+ int heap compiles to plain integer compares with no indirect calls.
+ The key type needs no minus infinity: heap_delete cuts the node and
+ extracts it directly.
+
+ Profiling (both off by default; every hook then compiles to nothing):
+  -DFIB_PROFILE  per-thread counters: operations, links, cuts, cascading
+                 cut depth, roots before/after each consolidation and
+                 the largest degree; fib_stats_dump() prints them as JSON.
+  -DFIB_TRACE    per-thread ring buffer of the last FIB_TRACE_SIZE
+                 insert/extract-min/decrease-key/delete latencies;
+                 fib_trace_dump() prints a log2 histogram per operation.
+
+ find_node() is the old O(n) search by key, kept for comparison.
+*/
+
+#ifndef FIB_KEY_T
+#define FIB_KEY_T int
+#endif
+
+#ifndef FIB_LESS
+#define FIB_LESS(a, b) ((a) < (b))
+#endif
+
+#ifndef FIB_EQUAL
+#define FIB_EQUAL(a, b) ((a) == (b))
+#endif
+
+#ifndef FIB_KEY_FMT
+#define FIB_KEY_FMT "%d"
+#endif
+
+#ifndef FIB_SLAB_NODES
+#define FIB_SLAB_NODES 1024
+#endif
+
+#define FIB_CASCADE_BUCKETS 16
+
+struct FibStats {
+    long inserts, extracts, decreases, deletes;
+    long links;          /* fib_link calls */
+    long cuts;           /* all cuts, from decrease-key and cascading */
+    long cascade_cuts;   /* cuts made by cascading_cut */
+    long cascade_depth[FIB_CASCADE_BUCKETS]; /* cascading_cut calls by cuts made, last = more */
+    int max_cascade;
+    long consolidations;
+    long roots_before;   /* summed over consolidations */
+    long roots_after;
+    int max_roots_before;
+    int max_degree;
+};
+
+#ifdef FIB_PROFILE
+static _Thread_local struct FibStats fib_stats;
+#define FIB_STAT(update) ((void)(fib_stats.update))
+#else
+#define FIB_STAT(update) ((void)0)
+#endif
+
+static inline long fib_cascade_begin(void) {
+#ifdef FIB_PROFILE
+    return fib_stats.cascade_cuts;
+#else
+    return 0;
+#endif
+}
+
+static inline void fib_cascade_end(long begin) {
+#ifdef FIB_PROFILE
+    long d = fib_stats.cascade_cuts - begin;
+    fib_stats.cascade_depth[d < FIB_CASCADE_BUCKETS ? d : FIB_CASCADE_BUCKETS - 1]++;
+    if (d > fib_stats.max_cascade) fib_stats.max_cascade = (int) d;
+#else
+    (void) begin;
+#endif
+}
+
+static inline long fib_consolidate_begin(void) {
+#ifdef FIB_PROFILE
+    return fib_stats.roots_before;
+#else
+    return 0;
+#endif
+}
+
+static inline void fib_consolidate_end(long begin) {
+#ifdef FIB_PROFILE
+    long roots = fib_stats.roots_before - begin;
+    fib_stats.consolidations++;
+    if (roots > fib_stats.max_roots_before) fib_stats.max_roots_before = (int) roots;
+#else
+    (void) begin;
+#endif
+}
+
+/* counters of the calling thread */
+static inline void fib_stats_get(struct FibStats *out) {
+#ifdef FIB_PROFILE
+    *out = fib_stats;
+#else
+    *out = (struct FibStats) {0};
+#endif
+}
+
+static inline void fib_stats_reset(void) {
+#ifdef FIB_PROFILE
+    fib_stats = (struct FibStats) {0};
+#endif
+}
+
+static inline void fib_stats_dump(FILE *f, const char *label) {
+    struct FibStats st;
+    fib_stats_get(&st);
+    long c = st.consolidations ? st.consolidations : 1;
+    fprintf(f, "{\"label\": \"%s\", \"inserts\": %ld, \"extracts\": %ld, \"decreases\": %ld, "
+            "\"deletes\": %ld, \"links\": %ld, \"cuts\": %ld, \"cascade_cuts\": %ld, "
+            "\"max_cascade\": %d, \"consolidations\": %ld, \"avg_roots_before\": %.2f, "
+            "\"avg_roots_after\": %.2f, \"max_roots_before\": %d, \"max_degree\": %d, "
+            "\"cascade_depth\": [", label, st.inserts, st.extracts, st.decreases, st.deletes,
+            st.links, st.cuts, st.cascade_cuts, st.max_cascade, st.consolidations,
+            (double) st.roots_before / c, (double) st.roots_after / c, st.max_roots_before,
+            st.max_degree);
+    for (int i = 0; i < FIB_CASCADE_BUCKETS; ++i)
+        fprintf(f, "%s%ld", i ? ", " : "", st.cascade_depth[i]);
+    fprintf(f, "]}\n");
+}
+
+enum { FIB_OP_INSERT, FIB_OP_EXTRACT, FIB_OP_DECREASE, FIB_OP_DELETE, FIB_OPS };
+
+#ifdef FIB_TRACE
+#include <time.h>
+
+#ifndef FIB_TRACE_SIZE
+#define FIB_TRACE_SIZE 65536 /* power of two */
+#endif
+
+struct FibTrace {
+    unsigned long long count;
+    unsigned int ns[FIB_TRACE_SIZE];
+    unsigned char op[FIB_TRACE_SIZE];
+};
+
+static _Thread_local struct FibTrace fib_trace;
+
+static inline long long fib_trace_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+static inline void fib_trace_record(int op, long long ns) {
+    unsigned long long i = fib_trace.count++ & (FIB_TRACE_SIZE - 1);
+    fib_trace.op[i] = (unsigned char) op;
+    fib_trace.ns[i] = ns > 0xffffffffLL ? 0xffffffffu : (unsigned int) ns;
+}
+
+#define FIB_TRACE_BEGIN() long long fib_trace_t0 = fib_trace_now()
+#define FIB_TRACE_END(op) fib_trace_record(op, fib_trace_now() - fib_trace_t0)
+#else
+#define FIB_TRACE_BEGIN() ((void)0)
+#define FIB_TRACE_END(op) ((void)0)
+#endif
+
+static inline void fib_trace_reset(void) {
+#ifdef FIB_TRACE
+    fib_trace.count = 0;
+#endif
+}
+
+/* histogram of the latencies still in the ring: bucket b holds [2^b, 2^(b+1)) ns */
+static inline void fib_trace_dump(FILE *f) {
+#ifdef FIB_TRACE
+    static const char *names[FIB_OPS] = {"insert", "extract-min", "decrease-key", "delete"};
+    unsigned long long n = fib_trace.count < FIB_TRACE_SIZE ? fib_trace.count : FIB_TRACE_SIZE;
+    long hist[FIB_OPS][32] = {{0}}, total[FIB_OPS] = {0};
+    for (unsigned long long i = 0; i < n; ++i) {
+        unsigned int ns = fib_trace.ns[i];
+        int b = ns ? 31 - __builtin_clz(ns) : 0;
+        hist[fib_trace.op[i]][b]++;
+        total[fib_trace.op[i]]++;
+    }
+    fprintf(f, "latency histogram of the last %llu operations (ns):\n", n);
+    for (int op = 0; op < FIB_OPS; ++op) {
+        if (total[op] == 0) continue;
+        fprintf(f, "  %s: %ld ops\n", names[op], total[op]);
+        for (int b = 0; b < 32; ++b) {
+            if (hist[op][b] == 0) continue;
+            int bar = (int) (50 * hist[op][b] / total[op]);
+            fprintf(f, "    [%10lu, %10lu) %9ld %6.2f%% ", 1ul << b, 2ul << b, hist[op][b],
+                    100.0 * hist[op][b] / total[op]);
+            for (int i = 0; i < bar; ++i) fputc('#', f);
+            fputc('\n', f);
+        }
+    }
+#else
+    fprintf(f, "latency trace not compiled in (build with -DFIB_TRACE)\n");
+#endif
+}
+
+typedef struct FibNode {
+    FIB_KEY_T key;
+#ifdef FIB_DATA_T
+    FIB_DATA_T data;
+#endif
+    int degree;
+    int mark; /* 0 or 1 */
+    int id;   /* index slot, -1 if not indexed */
+    struct FibNode *parent;
+    struct FibNode *child;
+    struct FibNode *left;
+    struct FibNode *right;
+} FibNode;
+
+typedef struct FibSlab {
+    struct FibSlab *next;
+    int cap;
+    FibNode nodes[];
+} FibSlab;
+
+typedef struct FibHeap {
+    FibNode *min;
+    int n; /* number of nodes */
+    FibNode **index; /* id -> node, NULL until the first heap_insert_id */
+    int index_cap;
+    FibSlab *slabs;      /* newest first; nodes are bump-allocated from the head */
+    int slab_used;       /* nodes handed out from the head slab */
+    int slab_nodes;      /* nodes per slab, 0 = malloc every node */
+    FibNode *free_list;  /* released nodes, chained through right */
+    FibNode **degree_table; /* consolidate's A[], all NULL between calls */
+    int degree_cap;
+    int degree_limit;       /* n at which degree_table must grow */
+} FibHeap;
+
+/* helper: get a node from the heap's pool (or malloc) */
+static inline FibNode* alloc_node(FibHeap *H) {
+    if (H->slab_nodes == 0) return (FibNode*) malloc(sizeof(FibNode));
+    FibNode *node = H->free_list;
+    if (node != NULL) {
+        H->free_list = node->right;
+        return node;
+    }
+    if (H->slabs == NULL || H->slab_used == H->slabs->cap) {
+        FibSlab *slab = (FibSlab*) malloc(sizeof(FibSlab) + H->slab_nodes * sizeof(FibNode));
+        slab->next = H->slabs;
+        slab->cap = H->slab_nodes;
+        H->slabs = slab;
+        H->slab_used = 0;
+    }
+    return &H->slabs->nodes[H->slab_used++];
+}
+
+/* internal: put the unused tail of H's head slab on its free list, so
+   nothing is stranded when another slab takes over the head */
+static inline void pool_release_tail(FibHeap *H) {
+    if (H->slabs == NULL) return;
+    while (H->slab_used < H->slabs->cap) {
+        FibNode *x = &H->slabs->nodes[H->slab_used++];
+        x->right = H->free_list;
+        H->free_list = x;
+    }
+}
+
+/* count contiguous fresh nodes from the pool, bypassing the free list;
+   NULL in malloc mode */
+static inline FibNode* pool_take(FibHeap *H, int count) {
+    if (H->slab_nodes == 0) return NULL;
+    if (H->slabs != NULL && H->slabs->cap - H->slab_used >= count) {
+        H->slab_used += count;
+        return &H->slabs->nodes[H->slab_used - count];
+    }
+    int dedicated = count >= H->slab_nodes;
+    int cap = dedicated ? count : H->slab_nodes;
+    FibSlab *slab = (FibSlab*) malloc(sizeof(FibSlab) + (size_t) cap * sizeof(FibNode));
+    slab->cap = cap;
+    if (dedicated && H->slabs != NULL) {
+        /* behind the head slab, which keeps bump-allocating its tail */
+        slab->next = H->slabs->next;
+        H->slabs->next = slab;
+        return slab->nodes;
+    }
+    pool_release_tail(H);
+    slab->next = H->slabs;
+    H->slabs = slab;
+    H->slab_used = count;
+    return slab->nodes;
+}
+
+/* give an extracted node back to the heap that allocated it */
+static inline void free_node(FibHeap *H, FibNode *x) {
+    if (x == NULL) return;
+    if (H->slab_nodes == 0) {
+        free(x);
+        return;
+    }
+    x->right = H->free_list;
+    H->free_list = x;
+}
+
+/* helper: create a new node */
+static inline FibNode* make_node(FibHeap *H, FIB_KEY_T key) {
+    FibNode *node = alloc_node(H);
+    node->key = key;
+    node->degree = 0;
+    node->mark = 0;
+    node->id = -1;
+    node->parent = NULL;
+    node->child = NULL;
+    node->left = node;
+    node->right = node;
+    return node;
+}
+
+/* create an empty heap whose pool allocates slab_nodes nodes at a time */
+static inline FibHeap* create_heap_slab(int slab_nodes) {
+    FibHeap *H = (FibHeap*) malloc(sizeof(FibHeap));
+    H->min = NULL;
+    H->n = 0;
+    H->index = NULL;
+    H->index_cap = 0;
+    H->slabs = NULL;
+    H->slab_used = 0;
+    H->slab_nodes = slab_nodes > 0 ? slab_nodes : 0;
+    H->free_list = NULL;
+    H->degree_table = NULL;
+    H->degree_cap = 0;
+    H->degree_limit = 0;
+    return H;
+}
+
+/* create an empty heap */
+static inline FibHeap* create_heap(void) {
+    return create_heap_slab(FIB_SLAB_NODES);
+}
+
+/* make sure index slot id exists */
+static inline void index_reserve(FibHeap *H, int id) {
+    if (id < H->index_cap) return;
+    int cap = H->index_cap ? H->index_cap : 16;
+    while (cap <= id) cap *= 2;
+    H->index = (FibNode**) realloc(H->index, cap * sizeof(FibNode*));
+    for (int i = H->index_cap; i < cap; ++i) H->index[i] = NULL;
+    H->index_cap = cap;
+}
+
+/* insert node into root list */
+static inline void insert_node(FibHeap *H, FibNode *x) {
+    if (H->min == NULL) {
+        H->min = x;
+    } else {
+        /* insert x into root list (to the right of min) */
+        x->right = H->min->right;
+        x->left = H->min;
+        H->min->right->left = x;
+        H->min->right = x;
+        if (FIB_LESS(x->key, H->min->key)) H->min = x;
+    }
+    H->n++;
+}
+
+/* insert key; the returned node is the handle for decrease_key/heap_delete */
+static inline FibNode* heap_insert(FibHeap *H, FIB_KEY_T key) {
+    FIB_TRACE_BEGIN();
+    FibNode *x = make_node(H, key);
+    insert_node(H, x);
+    FIB_STAT(inserts++);
+    FIB_TRACE_END(FIB_OP_INSERT);
+    return x;
+}
+
+/* insert key under a caller-chosen id >= 0; NULL if the id is in use */
+static inline FibNode* heap_insert_id(FibHeap *H, int id, FIB_KEY_T key) {
+    if (id < 0) return NULL;
+    index_reserve(H, id);
+    if (H->index[id] != NULL) return NULL;
+    FibNode *x = heap_insert(H, key);
+    x->id = id;
+    H->index[id] = x;
+    return x;
+}
+
+#ifdef FIB_DATA_T
+/* insert key with its payload */
+static inline FibNode* heap_insert_data(FibHeap *H, FIB_KEY_T key, FIB_DATA_T data) {
+    FibNode *x = heap_insert(H, key);
+    x->data = data;
+    return x;
+}
+#endif
+
+/* node currently stored under id, or NULL */
+static inline FibNode* heap_node(FibHeap *H, int id) {
+    if (id < 0 || id >= H->index_cap) return NULL;
+    return H->index[id];
+}
+
+/* meld H2 into H1: H1 gets all nodes, ids, slabs and free nodes of H2
+   and H2 is left empty. Indexed ids of the two heaps must not overlap,
+   and both must use the same allocation mode (pooled or malloc). */
+static inline void meld(FibHeap *H1, FibHeap *H2) {
+    if (H2->min != NULL) {
+        if (H1->min == NULL) {
+            H1->min = H2->min;
+        } else {
+            /* concatenate root lists H1 and H2 */
+            FibNode *a = H1->min->right;
+            FibNode *b = H2->min->left;
+
+            H1->min->right = H2->min;
+            H2->min->left = H1->min;
+
+            b->right = a;
+            a->left = b;
+
+            if (FIB_LESS(H2->min->key, H1->min->key)) H1->min = H2->min;
+        }
+    }
+    H1->n += H2->n;
+    for (int i = 0; i < H2->index_cap; ++i) {
+        if (H2->index[i] != NULL) {
+            index_reserve(H1, i);
+            H1->index[i] = H2->index[i];
+            H2->index[i] = NULL;
+        }
+    }
+    /* H2's slabs go behind H1's head slab, which keeps bump-allocating;
+       the unused tail of H2's head slab goes on the free list first */
+    if (H2->slabs != NULL) {
+        if (H1->slabs == NULL) {
+            H1->slabs = H2->slabs;
+            H1->slab_used = H2->slab_used;
+        } else {
+            pool_release_tail(H2);
+            FibSlab *tail = H2->slabs;
+            while (tail->next != NULL) tail = tail->next;
+            tail->next = H1->slabs->next;
+            H1->slabs->next = H2->slabs;
+        }
+    }
+    if (H2->free_list != NULL) {
+        FibNode *tail = H2->free_list;
+        while (tail->right != NULL) tail = tail->right;
+        tail->right = H1->free_list;
+        H1->free_list = H2->free_list;
+    }
+    H2->min = NULL;
+    H2->n = 0;
+    H2->slabs = NULL;
+    H2->slab_used = 0;
+    H2->free_list = NULL;
+}
+
+/* insert keys[0..n-1] with a single splice into the root list; if
+   handles is not NULL, handles[i] gets the node of keys[i] */
+static inline void heap_insert_batch(FibHeap *H, const FIB_KEY_T *keys, int n, FibNode **handles) {
+    if (n <= 0) return;
+    FibNode *nodes = pool_take(H, n);
+    FibNode *first = NULL, *last = NULL, *min = NULL;
+    for (int i = 0; i < n; ++i) {
+        FibNode *x = nodes != NULL ? &nodes[i] : alloc_node(H);
+        x->key = keys[i];
+        x->degree = 0;
+        x->mark = 0;
+        x->id = -1;
+        x->parent = NULL;
+        x->child = NULL;
+        if (first == NULL) {
+            first = min = x;
+        } else {
+            x->left = last;
+            last->right = x;
+            if (FIB_LESS(x->key, min->key)) min = x;
+        }
+        last = x;
+        if (handles) handles[i] = x;
+    }
+    if (H->min == NULL) {
+        last->right = first;
+        first->left = last;
+        H->min = min;
+    } else {
+        /* splice the chain in to the right of min */
+        FibNode *a = H->min->right;
+        H->min->right = first;
+        first->left = H->min;
+        last->right = a;
+        a->left = last;
+        if (FIB_LESS(min->key, H->min->key)) H->min = min;
+    }
+    H->n += n;
+    FIB_STAT(inserts += n);
+}
+
+/* new heap holding keys[0..n-1] */
+static inline FibHeap* heap_build(const FIB_KEY_T *keys, int n) {
+    FibHeap *H = create_heap();
+    heap_insert_batch(H, keys, n, NULL);
+    return H;
+}
+
+/* internal: make root y (already off any list) a child of x */
+static inline void fib_link(FibNode *y, FibNode *x) {
+    y->parent = x;
+    if (x->child == NULL) {
+        x->child = y;
+        y->right = y;
+        y->left = y;
+    } else {
+        y->right = x->child->right;
+        y->left = x->child;
+        x->child->right->left = y;
+        x->child->right = y;
+    }
+    x->degree++;
+    y->mark = 0;
+    FIB_STAT(links++);
+    FIB_STAT(max_degree = x->degree > fib_stats.max_degree ? x->degree : fib_stats.max_degree);
+}
+
+/* grow the degree table for H->n nodes: degrees stay <= k, the largest
+   k with F(k+2) <= n, and the table holds k + 2 slots */
+static inline void degree_table_reserve(FibHeap *H) {
+    int k = 0;
+    long a = 1, b = 2; /* F(k+2), F(k+3) */
+    while (b <= H->n) {
+        long t = a + b;
+        a = b;
+        b = t;
+        k++;
+    }
+    H->degree_limit = b > INT_MAX ? INT_MAX : (int) b;
+    if (k + 2 <= H->degree_cap) return;
+    H->degree_table = (FibNode**) realloc(H->degree_table, (k + 2) * sizeof(FibNode*));
+    for (int i = H->degree_cap; i < k + 2; ++i) H->degree_table[i] = NULL;
+    H->degree_cap = k + 2;
+}
+
+/* consolidate the roots of rings a and b (either may be NULL) so that no
+   two have the same degree, then rebuild the root list and min */
+static inline void consolidate(FibHeap *H, FibNode *a, FibNode *b) {
+    if (H->n >= H->degree_limit) degree_table_reserve(H);
+    FibNode **A = H->degree_table;
+    int top = -1;
+    long profile = fib_consolidate_begin();
+
+    FibNode *rings[2] = {a, b};
+    for (int r = 0; r < 2; ++r) {
+        if (rings[r] == NULL) continue;
+        rings[r]->left->right = NULL; /* walk the ring as a list */
+        FibNode *x = rings[r];
+        while (x != NULL) {
+            FibNode *next = x->right;
+            x->parent = NULL;
+            FIB_STAT(roots_before++);
+            int d = x->degree;
+            while (A[d] != NULL) {
+                FibNode *y = A[d];
+                A[d] = NULL;
+                if (FIB_LESS(y->key, x->key)) {
+                    FibNode *tmp = x; x = y; y = tmp;
+                }
+                fib_link(y, x);
+                d++;
+            }
+            A[d] = x;
+            if (d > top) top = d;
+            x = next;
+        }
+    }
+
+    /* rebuild root list from A, leaving A empty for the next call */
+    FibNode *first = NULL, *last = NULL, *min = NULL;
+    for (int i = 0; i <= top; ++i) {
+        FibNode *x = A[i];
+        if (x == NULL) continue;
+        A[i] = NULL;
+        if (first == NULL) {
+            first = x;
+        } else {
+            last->right = x;
+            x->left = last;
+        }
+        last = x;
+        if (min == NULL || FIB_LESS(x->key, min->key)) min = x;
+        FIB_STAT(roots_after++);
+    }
+    last->right = first;
+    first->left = last;
+    H->min = min;
+    fib_consolidate_end(profile);
+}
+
+/* internal: remove H->min from the heap and return it */
+static inline FibNode* remove_min(FibHeap *H) {
+    FibNode *z = H->min;
+    if (z != NULL) {
+        /* remove z from root list; its children are merged in by consolidate */
+        FibNode *rest = z->right == z ? NULL : z->right;
+        z->left->right = z->right;
+        z->right->left = z->left;
+        H->n--;
+        if (rest == NULL && z->child == NULL) H->min = NULL;
+        else consolidate(H, rest, z->child);
+        z->child = NULL;
+        if (z->id >= 0) H->index[z->id] = NULL;
+    }
+    return z;
+}
+
+/* extract and return min node (the caller frees it with free_node); its id becomes free */
+static inline FibNode* extract_min(FibHeap *H) {
+    FIB_TRACE_BEGIN();
+    FibNode *z = remove_min(H);
+    if (z != NULL) {
+        FIB_STAT(extracts++);
+        FIB_TRACE_END(FIB_OP_EXTRACT);
+    }
+    return z;
+}
+
+/* cut node x from its parent y and move x to root list */
+static inline void cut(FibHeap *H, FibNode *x, FibNode *y) {
+    /* remove x from child list of y */
+    if (y->child == x) {
+        if (x->right != x) y->child = x->right;
+        else y->child = NULL;
+    }
+    x->left->right = x->right;
+    x->right->left = x->left;
+    y->degree--;
+
+    /* add x to root list */
+    x->parent = NULL;
+    x->left = H->min;
+    x->right = H->min->right;
+    H->min->right->left = x;
+    H->min->right = x;
+    x->mark = 0;
+    FIB_STAT(cuts++);
+}
+
+/* cascading cut: while the parent is marked, cut it too */
+static inline void cascading_cut(FibHeap *H, FibNode *y) {
+    long profile = fib_cascade_begin();
+    FibNode *z = y->parent;
+    while (z != NULL && y->mark) {
+        cut(H, y, z);
+        FIB_STAT(cascade_cuts++);
+        y = z;
+        z = y->parent;
+    }
+    if (z != NULL) y->mark = 1;
+    fib_cascade_end(profile);
+}
+
+/* decrease key of node x to k; returns -1 (and changes nothing) if k is larger */
+static inline int decrease_key(FibHeap *H, FibNode *x, FIB_KEY_T k) {
+    if (FIB_LESS(x->key, k)) return -1;
+    FIB_TRACE_BEGIN();
+    x->key = k;
+    FibNode *y = x->parent;
+    if (y != NULL && FIB_LESS(x->key, y->key)) {
+        cut(H, x, y);
+        cascading_cut(H, y);
+    }
+    if (FIB_LESS(x->key, H->min->key)) H->min = x;
+    FIB_STAT(decreases++);
+    FIB_TRACE_END(FIB_OP_DECREASE);
+    return 0;
+}
+
+/* delete node x: move it to the root list as decrease-key would, then
+   extract it as if it were the minimum (consolidate finds the real one) */
+static inline void heap_delete(FibHeap *H, FibNode *x) {
+    FIB_TRACE_BEGIN();
+    FibNode *y = x->parent;
+    if (y != NULL) {
+        cut(H, x, y);
+        cascading_cut(H, y);
+    }
+    H->min = x;
+    free_node(H, remove_min(H));
+    FIB_STAT(deletes++);
+    FIB_TRACE_END(FIB_OP_DELETE);
+}
+
+/* id-based variants; -1 if no node has this id */
+static inline int decrease_key_id(FibHeap *H, int id, FIB_KEY_T k) {
+    FibNode *x = heap_node(H, id);
+    return x ? decrease_key(H, x, k) : -1;
+}
+
+static inline int delete_id(FibHeap *H, int id) {
+    FibNode *x = heap_node(H, id);
+    if (x == NULL) return -1;
+    heap_delete(H, x);
+    return 0;
+}
+
+/* utility: print root list and children counts (not exhaustive) */
+static inline void print_root_list(FibHeap *H) {
+    if (H->min == NULL) {
+        printf("Heap is empty.\n");
+        return;
+    }
+    printf("Root list (key:degree, [id] if indexed):\n");
+    FibNode *w = H->min;
+    FibNode *cur = w;
+    do {
+        printf(" " FIB_KEY_FMT ":%d", cur->key, cur->degree);
+        if (cur->id >= 0) printf("[%d]", cur->id);
+        cur = cur->right;
+    } while (cur != w);
+    printf("\n");
+}
+
+/* find a node by key in the heap (DFS). O(n): use handles or ids instead. */
+static inline FibNode* find_node_recursive(FibNode *start, FIB_KEY_T key) {
+    if (start == NULL) return NULL;
+    FibNode *cur = start;
+    do {
+        if (FIB_EQUAL(cur->key, key)) return cur;
+        FibNode *res = find_node_recursive(cur->child, key);
+        if (res != NULL) return res;
+        cur = cur->right;
+    } while (cur != start);
+    return NULL;
+}
+
+static inline FibNode* find_node(FibHeap *H, FIB_KEY_T key) {
+    if (H->min == NULL) return NULL;
+    return find_node_recursive(H->min, key);
+}
+
+/* free all nodes in heap (malloc mode): each child ring is spliced in
+   after its parent, so one loop visits every node */
+static inline void free_nodes(FibNode *start) {
+    if (start == NULL) return;
+    start->left->right = NULL;
+    FibNode *cur = start;
+    while (cur != NULL) {
+        if (cur->child) {
+            FibNode *c = cur->child;
+            c->left->right = cur->right;
+            cur->right = c;
+        }
+        FibNode *next = cur->right;
+        free(cur);
+        cur = next;
+    }
+}
+
+static inline void free_heap(FibHeap *H) {
+    if (H == NULL) return;
+    if (H->slab_nodes == 0) {
+        if (H->min) free_nodes(H->min);
+    } else {
+        while (H->slabs != NULL) {
+            FibSlab *next = H->slabs->next;
+            free(H->slabs);
+            H->slabs = next;
+        }
+    }
+    free(H->index);
+    free(H->degree_table);
+    free(H);
+}
+
+/* merge two heaps; returns H1, which now holds all nodes (H2 is freed) */
+static inline FibHeap* heap_union(FibHeap *H1, FibHeap *H2) {
+    meld(H1, H2);
+    free_heap(H2);
+    return H1;
+}
+
+#endif
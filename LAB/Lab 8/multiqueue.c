@@ -0,0 +1,456 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <limits.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+
+/*
+ MultiQueue: a relaxed concurrent priority queue built from fib_heap.h
+ - c * p sequential Fibonacci heaps, each behind a try-lock, with its
+   current minimum cached in an atomic so choosing needs no lock.
+ - insert: items go into a per-thread buffer of MQ_BUFFER entries; a
+   full buffer is flushed into one random heap that can be locked.
+ - delete-min: flush the own buffer, look at the cached minimum of two
+   random heaps and pop from the better one (retry on a busy lock).
+ The result is not always the global minimum; the "rank error" is how
+ many smaller items were in the queue at the time.
+ Benchmarks:
+ - parallel shortest paths: label-correcting Dijkstra where threads pop
+   (dist, vertex) pairs, skip stale ones and relax edges with a CAS on
+   dist[]. Compared with sequential Dijkstra on one Fibonacci heap
+   (decrease-key by vertex id): time, speedup, stale pops and extra
+   relaxations (the work the relaxation costs), distances must match.
+ - rank error: one thread, c * p heaps for several p, random inserts
+   and delete-mins; a Fenwick tree over the keys gives the exact rank
+   of every popped key.
+ Compile:
+   gcc -O2 -pthread -o multiqueue multiqueue.c -lm
+ Run:
+   ./multiqueue [grid|random] [vertices] [max_threads] [c]
+*/
+
+#define FIB_KEY_T long long
+#define FIB_KEY_FMT "%lld"
+#define FIB_DATA_T int
+#include "fib_heap.h"
+
+#define MQ_BUFFER 16
+#define MQ_EMPTY LLONG_MAX
+
+typedef struct MQHeap {
+    _Alignas(64) atomic_flag lock;
+    _Atomic long long top; /* key of the minimum, MQ_EMPTY if empty */
+    FibHeap *heap;
+} MQHeap;
+
+typedef struct MultiQueue {
+    int count;
+    MQHeap *q;
+} MultiQueue;
+
+/* per-thread state: random stream and insertion buffer */
+typedef struct MQThread {
+    MultiQueue *mq;
+    unsigned long long rng;
+    int buffered;
+    long long keys[MQ_BUFFER];
+    int vals[MQ_BUFFER];
+    long lock_fails;
+} MQThread;
+
+static MultiQueue* mq_create(int count) {
+    MultiQueue *mq = (MultiQueue*) malloc(sizeof(MultiQueue));
+    mq->count = count;
+    mq->q = (MQHeap*) aligned_alloc(64, count * sizeof(MQHeap));
+    for (int i = 0; i < count; ++i) {
+        atomic_flag_clear(&mq->q[i].lock);
+        atomic_init(&mq->q[i].top, MQ_EMPTY);
+        mq->q[i].heap = create_heap();
+    }
+    return mq;
+}
+
+static void mq_free(MultiQueue *mq) {
+    for (int i = 0; i < mq->count; ++i) free_heap(mq->q[i].heap);
+    free(mq->q);
+    free(mq);
+}
+
+static void mq_thread_init(MQThread *t, MultiQueue *mq, unsigned long long seed) {
+    t->mq = mq;
+    t->rng = seed * 0x9E3779B97F4A7C15ULL + 88172645463325252ULL;
+    t->buffered = 0;
+    t->lock_fails = 0;
+}
+
+static unsigned long long mq_rand(MQThread *t) {
+    t->rng ^= t->rng << 13;
+    t->rng ^= t->rng >> 7;
+    t->rng ^= t->rng << 17;
+    return t->rng;
+}
+
+static int mq_try_lock(MQHeap *h) {
+    return !atomic_flag_test_and_set_explicit(&h->lock, memory_order_acquire);
+}
+
+static void mq_unlock(MQHeap *h) {
+    FibNode *min = h->heap->min;
+    atomic_store_explicit(&h->top, min ? min->key : MQ_EMPTY, memory_order_relaxed);
+    atomic_flag_clear_explicit(&h->lock, memory_order_release);
+}
+
+/* after a busy lock; yield now and then in case the holder was preempted */
+static void mq_backoff(MQThread *t) {
+    if ((++t->lock_fails & 63) == 0) sched_yield();
+}
+
+/* move the thread's buffer into one random heap */
+static void mq_flush(MQThread *t) {
+    if (t->buffered == 0) return;
+    MultiQueue *mq = t->mq;
+    for (;;) {
+        MQHeap *h = &mq->q[mq_rand(t) % mq->count];
+        if (!mq_try_lock(h)) {
+            mq_backoff(t);
+            continue;
+        }
+        for (int i = 0; i < t->buffered; ++i) heap_insert_data(h->heap, t->keys[i], t->vals[i]);
+        mq_unlock(h);
+        t->buffered = 0;
+        return;
+    }
+}
+
+static void mq_insert(MQThread *t, long long key, int val) {
+    t->keys[t->buffered] = key;
+    t->vals[t->buffered++] = val;
+    if (t->buffered == MQ_BUFFER) mq_flush(t);
+}
+
+/* pop an item close to the minimum; 0 if every heap looked empty */
+static int mq_delete_min(MQThread *t, long long *key, int *val) {
+    MultiQueue *mq = t->mq;
+    mq_flush(t);
+    for (int attempt = 0;; ++attempt) {
+        MQHeap *a = &mq->q[mq_rand(t) % mq->count];
+        MQHeap *b = &mq->q[mq_rand(t) % mq->count];
+        long long ka = atomic_load_explicit(&a->top, memory_order_relaxed);
+        long long kb = atomic_load_explicit(&b->top, memory_order_relaxed);
+        MQHeap *h = kb < ka ? b : a;
+        if ((kb < ka ? kb : ka) == MQ_EMPTY) {
+            if (attempt < mq->count) continue;
+            /* many empty picks: scan before giving up */
+            int i = 0;
+            while (i < mq->count && atomic_load_explicit(&mq->q[i].top, memory_order_relaxed) == MQ_EMPTY) i++;
+            if (i == mq->count) return 0;
+            h = &mq->q[i];
+        }
+        if (!mq_try_lock(h)) {
+            mq_backoff(t);
+            continue;
+        }
+        FibNode *x = extract_min(h->heap);
+        if (x != NULL) {
+            *key = x->key;
+            *val = x->data;
+            free_node(h->heap, x);
+        }
+        mq_unlock(h);
+        if (x != NULL) return 1;
+    }
+}
+
+/* ---------- graphs ---------- */
+
+typedef struct Graph {
+    int n;
+    long m;
+    long *offset;
+    int *target;
+    int *weight;
+} Graph;
+
+static unsigned long long rng_state = 88172645463325252ULL;
+
+static unsigned long long rng_next(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return rng_state;
+}
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/* undirected CSR from an edge list */
+static Graph* build_csr(int n, long m, const int *eu, const int *ev, const int *ew) {
+    Graph *g = (Graph*) malloc(sizeof(Graph));
+    g->n = n;
+    g->m = 2 * m;
+    g->offset = (long*) calloc(n + 1, sizeof(long));
+    g->target = (int*) malloc(g->m * sizeof(int));
+    g->weight = (int*) malloc(g->m * sizeof(int));
+    for (long i = 0; i < m; ++i) {
+        g->offset[eu[i] + 1]++;
+        g->offset[ev[i] + 1]++;
+    }
+    for (int v = 0; v < n; ++v) g->offset[v + 1] += g->offset[v];
+    long *fill = (long*) malloc(n * sizeof(long));
+    memcpy(fill, g->offset, n * sizeof(long));
+    for (long i = 0; i < m; ++i) {
+        long a = fill[eu[i]]++, b = fill[ev[i]]++;
+        g->target[a] = ev[i];
+        g->weight[a] = ew[i];
+        g->target[b] = eu[i];
+        g->weight[b] = ew[i];
+    }
+    free(fill);
+    return g;
+}
+
+/* sqrt(n) x sqrt(n) lattice (road-like) or n vertices with 4 random
+   edges each plus a path through all of them */
+static Graph* make_graph(int grid, int n) {
+    int side = 1;
+    while ((long) (side + 1) * (side + 1) <= n) side++;
+    if (grid) n = side * side;
+    long m = grid ? 2L * side * (side - 1) : 5L * n, k = 0;
+    int *eu = (int*) malloc(m * sizeof(int));
+    int *ev = (int*) malloc(m * sizeof(int));
+    int *ew = (int*) malloc(m * sizeof(int));
+    for (int v = 0; v < n; ++v) {
+        if (grid) {
+            int r = v / side, c = v % side;
+            if (c + 1 < side) { eu[k] = v; ev[k] = v + 1; ew[k++] = 1 + (int) (rng_next() % 1000); }
+            if (r + 1 < side) { eu[k] = v; ev[k] = v + side; ew[k++] = 1 + (int) (rng_next() % 1000); }
+        } else {
+            if (v + 1 < n) { eu[k] = v; ev[k] = v + 1; ew[k++] = 1 + (int) (rng_next() % 1000000); }
+            for (int j = 0; j < 4; ++j) {
+                eu[k] = v;
+                ev[k] = (int) (rng_next() % (unsigned) n);
+                ew[k++] = 1 + (int) (rng_next() % 1000000);
+            }
+        }
+    }
+    Graph *g = build_csr(n, k, eu, ev, ew);
+    free(eu);
+    free(ev);
+    free(ew);
+    return g;
+}
+
+static void free_graph(Graph *g) {
+    free(g->offset);
+    free(g->target);
+    free(g->weight);
+    free(g);
+}
+
+/* ---------- shortest paths ---------- */
+
+/* exact Dijkstra on one Fibonacci heap; returns relaxations */
+static long dijkstra_sequential(const Graph *g, long long *dist) {
+    FibHeap *H = create_heap();
+    long relax = 0;
+    for (int v = 0; v < g->n; ++v) dist[v] = MQ_EMPTY;
+    dist[0] = 0;
+    heap_insert_id(H, 0, 0);
+    FibNode *x;
+    while ((x = extract_min(H)) != NULL) {
+        int u = x->id;
+        long long d = x->key;
+        free_node(H, x);
+        for (long e = g->offset[u]; e < g->offset[u + 1]; ++e) {
+            int v = g->target[e];
+            long long nd = d + g->weight[e];
+            if (nd < dist[v]) {
+                if (dist[v] == MQ_EMPTY) heap_insert_id(H, v, nd);
+                else decrease_key_id(H, v, nd);
+                dist[v] = nd;
+                relax++;
+            }
+        }
+    }
+    free_heap(H);
+    return relax;
+}
+
+typedef struct SSSP {
+    const Graph *g;
+    _Atomic long long *dist;
+    atomic_long pending; /* items inserted but not yet fully processed */
+} SSSP;
+
+typedef struct Worker {
+    pthread_t tid;
+    SSSP *s;
+    MQThread t;
+    long pops, stale, relax;
+} Worker;
+
+static void* sssp_worker(void *arg) {
+    Worker *w = (Worker*) arg;
+    const Graph *g = w->s->g;
+    _Atomic long long *dist = w->s->dist;
+    long long d;
+    int u;
+    for (;;) {
+        if (!mq_delete_min(&w->t, &d, &u)) {
+            if (atomic_load(&w->s->pending) == 0) break;
+            sched_yield();
+            continue;
+        }
+        w->pops++;
+        if (d > atomic_load_explicit(&dist[u], memory_order_relaxed)) {
+            w->stale++;
+        } else {
+            for (long e = g->offset[u]; e < g->offset[u + 1]; ++e) {
+                int v = g->target[e];
+                long long nd = d + g->weight[e];
+                long long cur = atomic_load_explicit(&dist[v], memory_order_relaxed);
+                while (nd < cur) {
+                    if (atomic_compare_exchange_weak_explicit(&dist[v], &cur, nd,
+                            memory_order_relaxed, memory_order_relaxed)) {
+                        atomic_fetch_add(&w->s->pending, 1);
+                        mq_insert(&w->t, nd, v);
+                        w->relax++;
+                        break;
+                    }
+                }
+            }
+        }
+        atomic_fetch_sub(&w->s->pending, 1);
+    }
+    return NULL;
+}
+
+static void run_parallel(const Graph *g, int threads, int c, const long long *ref,
+                         double t_seq, long relax_seq) {
+    SSSP s;
+    s.g = g;
+    s.dist = (_Atomic long long*) malloc(g->n * sizeof(long long));
+    for (int v = 0; v < g->n; ++v) atomic_init(&s.dist[v], MQ_EMPTY);
+    atomic_init(&s.pending, 1);
+
+    MultiQueue *mq = mq_create(c * threads);
+    Worker *w = (Worker*) calloc(threads, sizeof(Worker));
+    for (int i = 0; i < threads; ++i) {
+        w[i].s = &s;
+        mq_thread_init(&w[i].t, mq, i + 1);
+    }
+    double t0 = now_sec();
+    atomic_store(&s.dist[0], 0);
+    mq_insert(&w[0].t, 0, 0);
+    for (int i = 0; i < threads; ++i) pthread_create(&w[i].tid, NULL, sssp_worker, &w[i]);
+    for (int i = 0; i < threads; ++i) pthread_join(w[i].tid, NULL);
+    double t = now_sec() - t0;
+
+    long pops = 0, stale = 0, relax = 0, fails = 0;
+    for (int i = 0; i < threads; ++i) {
+        pops += w[i].pops;
+        stale += w[i].stale;
+        relax += w[i].relax;
+        fails += w[i].t.lock_fails;
+    }
+    int ok = 1;
+    for (int v = 0; v < g->n && ok; ++v) ok = atomic_load(&s.dist[v]) == ref[v];
+    printf("%7d %6d %9.3f %8.2f %12ld %10.2f%% %12.2f %11ld  %s\n", threads, c * threads, t,
+           t_seq / t, pops, 100.0 * stale / (pops ? pops : 1), (double) relax / relax_seq, fails,
+           ok ? "OK" : "MISMATCH");
+
+    mq_free(mq);
+    free(w);
+    free(s.dist);
+}
+
+/* ---------- rank error ---------- */
+
+#define RANK_BITS 20
+
+static void fenwick_add(int *f, int i, int d) {
+    for (++i; i <= (1 << RANK_BITS); i += i & -i) f[i] += d;
+}
+
+static long fenwick_below(const int *f, int i) { /* count of keys < i */
+    long s = 0;
+    for (; i > 0; i -= i & -i) s += f[i];
+    return s;
+}
+
+static int cmp_long(const void *a, const void *b) {
+    long x = *(const long*) a, y = *(const long*) b;
+    return x < y ? -1 : x > y;
+}
+
+static void rank_error(int heaps, int size, int ops) {
+    MultiQueue *mq = mq_create(heaps);
+    MQThread t;
+    mq_thread_init(&t, mq, 7);
+    int *f = (int*) calloc((1 << RANK_BITS) + 1, sizeof(int));
+    long *rank = (long*) malloc(ops * sizeof(long));
+    for (int i = 0; i < size; ++i) {
+        int k = (int) (mq_rand(&t) % (1 << RANK_BITS));
+        mq_insert(&t, k, 0);
+        fenwick_add(f, k, 1);
+    }
+    long long key;
+    int val;
+    double sum = 0;
+    for (int i = 0; i < ops; ++i) {
+        mq_delete_min(&t, &key, &val);
+        rank[i] = fenwick_below(f, (int) key);
+        sum += rank[i];
+        fenwick_add(f, (int) key, -1);
+        int k = (int) (mq_rand(&t) % (1 << RANK_BITS));
+        mq_insert(&t, k, 0);
+        fenwick_add(f, k, 1);
+    }
+    qsort(rank, ops, sizeof(long), cmp_long);
+    printf("%7d %10.2f %8ld %8ld %8ld\n", heaps, sum / ops, rank[ops / 2], rank[(int) (ops * 0.99)],
+           rank[ops - 1]);
+    free(rank);
+    free(f);
+    mq_free(mq);
+}
+
+int main(int argc, char **argv) {
+    int grid = argc > 1 && strcmp(argv[1], "grid") == 0;
+    int n = argc > 2 ? (int) atof(argv[2]) : 1000000;
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    int max_threads = argc > 3 ? atoi(argv[3]) : (cpus > 4 ? (int) cpus : 4);
+    int c = argc > 4 ? atoi(argv[4]) : 2;
+    if (n < 2) n = 2;
+    if (max_threads < 1) max_threads = 1;
+    if (c < 1) c = 1;
+
+    Graph *g = make_graph(grid, n);
+    long long *ref = (long long*) malloc(g->n * sizeof(long long));
+    double t0 = now_sec();
+    long relax_seq = dijkstra_sequential(g, ref);
+    double t_seq = now_sec() - t0;
+
+    printf("%s graph: %d vertices, %ld arcs, %ld CPUs online\n", grid ? "grid" : "random", g->n, g->m, cpus);
+    printf("sequential Dijkstra (Fibonacci heap, decrease-key): %.3f s, %ld relaxations\n", t_seq, relax_seq);
+    printf("%7s %6s %9s %8s %12s %11s %12s %11s\n", "threads", "heaps", "time s", "speedup",
+           "pops", "stale", "relax/seq", "lock fails");
+    for (int p = 1; p <= max_threads; p *= 2) {
+        run_parallel(g, p, c, ref, t_seq, relax_seq);
+        if (p < max_threads && p * 2 > max_threads) run_parallel(g, max_threads, c, ref, t_seq, relax_seq);
+    }
+
+    printf("\nrank error of delete-min (one thread, 1e6 keys, 1e6 pops):\n");
+    printf("%7s %10s %8s %8s %8s\n", "heaps", "mean", "p50", "p99", "max");
+    for (int p = 1; p <= 64; p *= 2) rank_error(c * p, 1000000, 1000000);
+
+    free(ref);
+    free_graph(g);
+    return 0;
+}
@@ -0,0 +1,669 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/resource.h>
+
+/*
+ Dijkstra and Prim over a CSR graph with pluggable priority queues
+ - fibonacci: fib_heap.h, nodes addressed by vertex id
+ - binary:    array heap with a vertex -> position index
+ - pairing:   two-pass pairing heap stored in per-vertex arrays
+ - radix:     radix heap for integer keys; it needs keys that never go
+              below the last extracted one, so it only runs Dijkstra
+              (Prim's keys are edge weights and are not monotone)
+ All queues implement the PQOps interface (insert, decrease, pop) and
+ hold vertex ids 0..n-1. The driver counts inserts, decrease-keys and
+ pops, times each run, reports the queue's own peak memory and checks
+ that every queue gives the same distances / spanning tree weight.
+ Graphs:
+   grid    road-like: sqrt(n) x sqrt(n) lattice, weights 1..1000
+   random  n vertices, <degree> random edges per vertex plus a path
+           0-1-...-(n-1) so it is connected, weights 1..1000000
+   <file>  DIMACS shortest-path format (p sp n m / a u v w), e.g. the
+           USA road networks of the 9th DIMACS challenge
+ Built with -DFIB_PROFILE and/or -DFIB_TRACE, the fibonacci runs also
+ print the heap's link/cut/consolidation counters and latency histogram.
+ Compile:
+   gcc -O2 -o shortest_paths shortest_paths.c -lm
+   gcc -O2 -DFIB_PROFILE -DFIB_TRACE -o shortest_paths shortest_paths.c -lm
+ Run:
+   ./shortest_paths [grid|random|both|file.gr] [vertices] [degree]
+   e.g. ./shortest_paths both 10000000
+*/
+
+#define FIB_KEY_T long long
+#define FIB_KEY_FMT "%lld"
+#include "fib_heap.h"
+
+#define INF_KEY 0x3fffffffffffffffLL
+
+typedef struct Graph {
+    int n;
+    long m;          /* arcs (an undirected edge is two arcs) */
+    long *offset;    /* arcs of u are offset[u] .. offset[u+1]-1 */
+    int *target;
+    int *weight;
+} Graph;
+
+/* ---------- priority queue interface ---------- */
+
+typedef struct PQOps {
+    const char *name;
+    int monotone_only; /* only valid when keys never drop below the last pop */
+    void* (*create)(int n);
+    void (*insert)(void *q, int v, long long key);
+    void (*decrease)(void *q, int v, long long key);
+    int (*pop)(void *q, long long *key); /* vertex, or -1 if empty */
+    size_t (*bytes)(void *q);
+    void (*destroy)(void *q);
+} PQOps;
+
+/* Fibonacci heap */
+static void* fib_create(int n) {
+    FibHeap *H = create_heap();
+    index_reserve(H, n - 1);
+    return H;
+}
+
+static void fib_insert(void *q, int v, long long key) {
+    heap_insert_id((FibHeap*) q, v, key);
+}
+
+static void fib_decrease(void *q, int v, long long key) {
+    decrease_key_id((FibHeap*) q, v, key);
+}
+
+static int fib_pop(void *q, long long *key) {
+    FibHeap *H = (FibHeap*) q;
+    FibNode *x = extract_min(H);
+    if (x == NULL) return -1;
+    int v = x->id;
+    *key = x->key;
+    free_node(H, x);
+    return v;
+}
+
+static size_t fib_bytes(void *q) {
+    FibHeap *H = (FibHeap*) q;
+    size_t b = sizeof(FibHeap) + H->index_cap * sizeof(FibNode*);
+    for (FibSlab *s = H->slabs; s != NULL; s = s->next)
+        b += sizeof(FibSlab) + s->cap * sizeof(FibNode);
+    return b;
+}
+
+static void fib_destroy(void *q) {
+    free_heap((FibHeap*) q);
+}
+
+/* binary heap */
+typedef struct BinHeap {
+    int size, n;
+    int *heap;        /* vertices */
+    int *pos;         /* vertex -> index in heap */
+    long long *key;   /* per vertex */
+} BinHeap;
+
+static void* bin_create(int n) {
+    BinHeap *h = (BinHeap*) malloc(sizeof(BinHeap));
+    h->size = 0;
+    h->n = n;
+    h->heap = (int*) malloc(n * sizeof(int));
+    h->pos = (int*) malloc(n * sizeof(int));
+    h->key = (long long*) malloc(n * sizeof(long long));
+    return h;
+}
+
+static void bin_sift_up(BinHeap *h, int i) {
+    int v = h->heap[i];
+    long long k = h->key[v];
+    while (i > 0) {
+        int p = (i - 1) / 2;
+        if (h->key[h->heap[p]] <= k) break;
+        h->heap[i] = h->heap[p];
+        h->pos[h->heap[i]] = i;
+        i = p;
+    }
+    h->heap[i] = v;
+    h->pos[v] = i;
+}
+
+static void bin_sift_down(BinHeap *h, int i) {
+    int v = h->heap[i];
+    long long k = h->key[v];
+    for (;;) {
+        int c = 2 * i + 1;
+        if (c >= h->size) break;
+        if (c + 1 < h->size && h->key[h->heap[c + 1]] < h->key[h->heap[c]]) c++;
+        if (k <= h->key[h->heap[c]]) break;
+        h->heap[i] = h->heap[c];
+        h->pos[h->heap[i]] = i;
+        i = c;
+    }
+    h->heap[i] = v;
+    h->pos[v] = i;
+}
+
+static void bin_insert(void *q, int v, long long key) {
+    BinHeap *h = (BinHeap*) q;
+    h->key[v] = key;
+    h->heap[h->size] = v;
+    bin_sift_up(h, h->size++);
+}
+
+static void bin_decrease(void *q, int v, long long key) {
+    BinHeap *h = (BinHeap*) q;
+    h->key[v] = key;
+    bin_sift_up(h, h->pos[v]);
+}
+
+static int bin_pop(void *q, long long *key) {
+    BinHeap *h = (BinHeap*) q;
+    if (h->size == 0) return -1;
+    int v = h->heap[0];
+    *key = h->key[v];
+    if (--h->size > 0) {
+        h->heap[0] = h->heap[h->size];
+        bin_sift_down(h, 0);
+    }
+    return v;
+}
+
+static size_t bin_bytes(void *q) {
+    BinHeap *h = (BinHeap*) q;
+    return sizeof(BinHeap) + (size_t) h->n * (2 * sizeof(int) + sizeof(long long));
+}
+
+static void bin_destroy(void *q) {
+    BinHeap *h = (BinHeap*) q;
+    free(h->heap);
+    free(h->pos);
+    free(h->key);
+    free(h);
+}
+
+/* pairing heap: prev is the left sibling, or the parent for a first child */
+typedef struct PairHeap {
+    int root, n;
+    int *child, *sibling, *prev;
+    long long *key;
+} PairHeap;
+
+static void* pair_create(int n) {
+    PairHeap *h = (PairHeap*) malloc(sizeof(PairHeap));
+    h->root = -1;
+    h->n = n;
+    h->child = (int*) malloc(n * sizeof(int));
+    h->sibling = (int*) malloc(n * sizeof(int));
+    h->prev = (int*) malloc(n * sizeof(int));
+    h->key = (long long*) malloc(n * sizeof(long long));
+    return h;
+}
+
+/* meld two roots (no siblings); the larger becomes the first child */
+static int pair_meld(PairHeap *h, int a, int b) {
+    if (a < 0) return b;
+    if (b < 0) return a;
+    if (h->key[b] < h->key[a]) {
+        int t = a; a = b; b = t;
+    }
+    h->sibling[b] = h->child[a];
+    if (h->child[a] >= 0) h->prev[h->child[a]] = b;
+    h->prev[b] = a;
+    h->child[a] = b;
+    return a;
+}
+
+static void pair_insert(void *q, int v, long long key) {
+    PairHeap *h = (PairHeap*) q;
+    h->key[v] = key;
+    h->child[v] = h->sibling[v] = h->prev[v] = -1;
+    h->root = pair_meld(h, h->root, v);
+}
+
+static void pair_decrease(void *q, int v, long long key) {
+    PairHeap *h = (PairHeap*) q;
+    h->key[v] = key;
+    if (v == h->root) return;
+    /* cut the subtree of v and meld it with the root */
+    int p = h->prev[v];
+    if (h->child[p] == v) h->child[p] = h->sibling[v];
+    else h->sibling[p] = h->sibling[v];
+    if (h->sibling[v] >= 0) h->prev[h->sibling[v]] = p;
+    h->sibling[v] = h->prev[v] = -1;
+    h->root = pair_meld(h, h->root, v);
+}
+
+static int pair_pop(void *q, long long *key) {
+    PairHeap *h = (PairHeap*) q;
+    int r = h->root;
+    if (r < 0) return -1;
+    *key = h->key[r];
+    /* pass 1: meld children in pairs left to right, stacking the results */
+    int list = -1, c = h->child[r];
+    while (c >= 0) {
+        int a = c, b = h->sibling[a];
+        c = b >= 0 ? h->sibling[b] : -1;
+        h->sibling[a] = h->prev[a] = -1;
+        if (b >= 0) h->sibling[b] = h->prev[b] = -1;
+        int m = pair_meld(h, a, b);
+        h->sibling[m] = list;
+        list = m;
+    }
+    /* pass 2: meld the stack right to left */
+    int root = -1;
+    while (list >= 0) {
+        int next = h->sibling[list];
+        h->sibling[list] = -1;
+        root = pair_meld(h, root, list);
+        list = next;
+    }
+    if (root >= 0) h->prev[root] = -1;
+    h->root = root;
+    return r;
+}
+
+static size_t pair_bytes(void *q) {
+    PairHeap *h = (PairHeap*) q;
+    return sizeof(PairHeap) + (size_t) h->n * (3 * sizeof(int) + sizeof(long long));
+}
+
+static void pair_destroy(void *q) {
+    PairHeap *h = (PairHeap*) q;
+    free(h->child);
+    free(h->sibling);
+    free(h->prev);
+    free(h->key);
+    free(h);
+}
+
+/* radix heap: bucket 0 holds keys equal to last, bucket b holds keys
+   whose highest bit differing from last is bit b-1 */
+typedef struct RadixHeap {
+    long long last;
+    int n;
+    int head[65];
+    int *next, *prev;
+    unsigned char *bucket;
+    long long *key;
+} RadixHeap;
+
+static void* radix_create(int n) {
+    RadixHeap *h = (RadixHeap*) malloc(sizeof(RadixHeap));
+    h->last = 0;
+    h->n = n;
+    for (int i = 0; i < 65; ++i) h->head[i] = -1;
+    h->next = (int*) malloc(n * sizeof(int));
+    h->prev = (int*) malloc(n * sizeof(int));
+    h->bucket = (unsigned char*) malloc(n);
+    h->key = (long long*) malloc(n * sizeof(long long));
+    return h;
+}
+
+static int radix_bucket(RadixHeap *h, long long key) {
+    return key == h->last ? 0 : 64 - __builtin_clzll((unsigned long long) (key ^ h->last));
+}
+
+static void radix_link(RadixHeap *h, int v) {
+    int b = radix_bucket(h, h->key[v]);
+    h->bucket[v] = (unsigned char) b;
+    h->prev[v] = -1;
+    h->next[v] = h->head[b];
+    if (h->head[b] >= 0) h->prev[h->head[b]] = v;
+    h->head[b] = v;
+}
+
+static void radix_unlink(RadixHeap *h, int v) {
+    if (h->prev[v] >= 0) h->next[h->prev[v]] = h->next[v];
+    else h->head[h->bucket[v]] = h->next[v];
+    if (h->next[v] >= 0) h->prev[h->next[v]] = h->prev[v];
+}
+
+static void radix_insert(void *q, int v, long long key) {
+    RadixHeap *h = (RadixHeap*) q;
+    h->key[v] = key;
+    radix_link(h, v);
+}
+
+static void radix_decrease(void *q, int v, long long key) {
+    RadixHeap *h = (RadixHeap*) q;
+    radix_unlink(h, v);
+    h->key[v] = key;
+    radix_link(h, v);
+}
+
+static int radix_pop(void *q, long long *key) {
+    RadixHeap *h = (RadixHeap*) q;
+    if (h->head[0] < 0) {
+        int b = 1;
+        while (b < 65 && h->head[b] < 0) b++;
+        if (b == 65) return -1;
+        /* new last = smallest key of bucket b; its members all move lower */
+        long long m = INF_KEY;
+        for (int v = h->head[b]; v >= 0; v = h->next[v])
+            if (h->key[v] < m) m = h->key[v];
+        h->last = m;
+        int v = h->head[b];
+        h->head[b] = -1;
+        while (v >= 0) {
+            int next = h->next[v];
+            radix_link(h, v);
+            v = next;
+        }
+    }
+    int v = h->head[0];
+    radix_unlink(h, v);
+    *key = h->key[v];
+    return v;
+}
+
+static size_t radix_bytes(void *q) {
+    RadixHeap *h = (RadixHeap*) q;
+    return sizeof(RadixHeap) + (size_t) h->n * (2 * sizeof(int) + 1 + sizeof(long long));
+}
+
+static void radix_destroy(void *q) {
+    RadixHeap *h = (RadixHeap*) q;
+    free(h->next);
+    free(h->prev);
+    free(h->bucket);
+    free(h->key);
+    free(h);
+}
+
+static const PQOps queues[] = {
+    {"fibonacci", 0, fib_create, fib_insert, fib_decrease, fib_pop, fib_bytes, fib_destroy},
+    {"binary", 0, bin_create, bin_insert, bin_decrease, bin_pop, bin_bytes, bin_destroy},
+    {"pairing", 0, pair_create, pair_insert, pair_decrease, pair_pop, pair_bytes, pair_destroy},
+    {"radix", 1, radix_create, radix_insert, radix_decrease, radix_pop, radix_bytes, radix_destroy},
+};
+
+/* ---------- algorithms ---------- */
+
+typedef struct RunStats {
+    long inserts, decreases, pops;
+    size_t queue_bytes;
+    double seconds;
+} RunStats;
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/* single-source shortest paths from s into dist */
+static void dijkstra(const Graph *g, int s, const PQOps *ops, long long *dist, RunStats *st) {
+    memset(st, 0, sizeof(*st));
+    double t0 = now_sec();
+    void *q = ops->create(g->n);
+    for (int v = 0; v < g->n; ++v) dist[v] = INF_KEY;
+    dist[s] = 0;
+    ops->insert(q, s, 0);
+    st->inserts++;
+    long long d;
+    int u;
+    while ((u = ops->pop(q, &d)) >= 0) {
+        st->pops++;
+        for (long e = g->offset[u]; e < g->offset[u + 1]; ++e) {
+            int v = g->target[e];
+            long long nd = d + g->weight[e];
+            if (nd < dist[v]) {
+                /* nd < dist[v] and nd >= d, so v cannot have been popped yet */
+                if (dist[v] == INF_KEY) {
+                    ops->insert(q, v, nd);
+                    st->inserts++;
+                } else {
+                    ops->decrease(q, v, nd);
+                    st->decreases++;
+                }
+                dist[v] = nd;
+            }
+        }
+    }
+    st->queue_bytes = ops->bytes(q);
+    ops->destroy(q);
+    st->seconds = now_sec() - t0;
+}
+
+/* minimum spanning tree (forest of the component of s); returns its weight */
+static long long prim(const Graph *g, int s, const PQOps *ops, long long *key, RunStats *st) {
+    memset(st, 0, sizeof(*st));
+    double t0 = now_sec();
+    void *q = ops->create(g->n);
+    char *in_tree = (char*) calloc(g->n, 1);
+    for (int v = 0; v < g->n; ++v) key[v] = INF_KEY;
+    key[s] = 0;
+    ops->insert(q, s, 0);
+    st->inserts++;
+    long long total = 0, d;
+    int u;
+    while ((u = ops->pop(q, &d)) >= 0) {
+        st->pops++;
+        in_tree[u] = 1;
+        total += d;
+        for (long e = g->offset[u]; e < g->offset[u + 1]; ++e) {
+            int v = g->target[e];
+            if (!in_tree[v] && g->weight[e] < key[v]) {
+                if (key[v] == INF_KEY) {
+                    ops->insert(q, v, g->weight[e]);
+                    st->inserts++;
+                } else {
+                    ops->decrease(q, v, g->weight[e]);
+                    st->decreases++;
+                }
+                key[v] = g->weight[e];
+            }
+        }
+    }
+    free(in_tree);
+    st->queue_bytes = ops->bytes(q);
+    ops->destroy(q);
+    st->seconds = now_sec() - t0;
+    return total;
+}
+
+/* ---------- graphs ---------- */
+
+static unsigned long long rng_state = 88172645463325252ULL;
+
+static unsigned long long rng_next(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return rng_state;
+}
+
+/* CSR from an edge list; undirected edges are stored in both directions */
+static Graph* build_csr(int n, long m, const int *eu, const int *ev, const int *ew, int undirected) {
+    Graph *g = (Graph*) malloc(sizeof(Graph));
+    g->n = n;
+    g->m = undirected ? 2 * m : m;
+    g->offset = (long*) calloc(n + 1, sizeof(long));
+    g->target = (int*) malloc(g->m * sizeof(int));
+    g->weight = (int*) malloc(g->m * sizeof(int));
+    for (long i = 0; i < m; ++i) {
+        g->offset[eu[i] + 1]++;
+        if (undirected) g->offset[ev[i] + 1]++;
+    }
+    for (int v = 0; v < n; ++v) g->offset[v + 1] += g->offset[v];
+    long *fill = (long*) malloc(n * sizeof(long));
+    memcpy(fill, g->offset, n * sizeof(long));
+    for (long i = 0; i < m; ++i) {
+        long a = fill[eu[i]]++;
+        g->target[a] = ev[i];
+        g->weight[a] = ew[i];
+        if (undirected) {
+            long b = fill[ev[i]]++;
+            g->target[b] = eu[i];
+            g->weight[b] = ew[i];
+        }
+    }
+    free(fill);
+    return g;
+}
+
+static Graph* make_grid(int n) {
+    int side = 1;
+    while ((long) (side + 1) * (side + 1) <= n) side++;
+    n = side * side;
+    long m = 2L * side * (side - 1), k = 0;
+    int *eu = (int*) malloc(m * sizeof(int));
+    int *ev = (int*) malloc(m * sizeof(int));
+    int *ew = (int*) malloc(m * sizeof(int));
+    for (int r = 0; r < side; ++r) {
+        for (int c = 0; c < side; ++c) {
+            int v = r * side + c;
+            if (c + 1 < side) { eu[k] = v; ev[k] = v + 1; ew[k++] = 1 + (int) (rng_next() % 1000); }
+            if (r + 1 < side) { eu[k] = v; ev[k] = v + side; ew[k++] = 1 + (int) (rng_next() % 1000); }
+        }
+    }
+    Graph *g = build_csr(n, m, eu, ev, ew, 1);
+    free(eu);
+    free(ev);
+    free(ew);
+    return g;
+}
+
+static Graph* make_random(int n, int degree) {
+    long m = (long) n * degree + (n - 1), k = 0;
+    int *eu = (int*) malloc(m * sizeof(int));
+    int *ev = (int*) malloc(m * sizeof(int));
+    int *ew = (int*) malloc(m * sizeof(int));
+    for (int v = 0; v + 1 < n; ++v) {
+        eu[k] = v; ev[k] = v + 1; ew[k++] = 1 + (int) (rng_next() % 1000000);
+    }
+    for (int v = 0; v < n; ++v) {
+        for (int j = 0; j < degree; ++j) {
+            eu[k] = v;
+            ev[k] = (int) (rng_next() % (unsigned) n);
+            ew[k++] = 1 + (int) (rng_next() % 1000000);
+        }
+    }
+    Graph *g = build_csr(n, m, eu, ev, ew, 1);
+    free(eu);
+    free(ev);
+    free(ew);
+    return g;
+}
+
+/* DIMACS: "p sp <n> <m>" then "a <u> <v> <w>" arcs, 1-based; "c" comments */
+static Graph* load_dimacs(const char *path) {
+    FILE *f = fopen(path, "r");
+    if (f == NULL) return NULL;
+    char line[256];
+    int n = 0;
+    long m = 0, k = 0;
+    int *eu = NULL, *ev = NULL, *ew = NULL;
+    while (fgets(line, sizeof(line), f) != NULL) {
+        if (line[0] == 'p') {
+            if (sscanf(line, "p sp %d %ld", &n, &m) != 2) break;
+            eu = (int*) malloc(m * sizeof(int));
+            ev = (int*) malloc(m * sizeof(int));
+            ew = (int*) malloc(m * sizeof(int));
+        } else if (line[0] == 'a' && eu != NULL && k < m) {
+            int u, v, w;
+            if (sscanf(line, "a %d %d %d", &u, &v, &w) == 3 && u >= 1 && u <= n && v >= 1 && v <= n && w >= 0) {
+                eu[k] = u - 1; ev[k] = v - 1; ew[k++] = w;
+            }
+        }
+    }
+    fclose(f);
+    Graph *g = eu != NULL ? build_csr(n, k, eu, ev, ew, 0) : NULL;
+    free(eu);
+    free(ev);
+    free(ew);
+    return g;
+}
+
+static void free_graph(Graph *g) {
+    free(g->offset);
+    free(g->target);
+    free(g->weight);
+    free(g);
+}
+
+static void print_row(const char *algo, const char *queue, const RunStats *st, int ok) {
+    printf("%-8s %-10s %8.3f %12ld %12ld %12ld %10.1f  %s\n", algo, queue, st->seconds,
+           st->inserts, st->decreases, st->pops, st->queue_bytes / 1e6, ok ? "OK" : "MISMATCH");
+}
+
+/* counters and latencies of the fibonacci run that just finished */
+static void fib_report(const char *algo) {
+#if defined(FIB_PROFILE) || defined(FIB_TRACE)
+#ifdef FIB_PROFILE
+    fib_stats_dump(stdout, algo);
+#else
+    (void) algo;
+#endif
+#ifdef FIB_TRACE
+    fib_trace_dump(stdout);
+#endif
+#else
+    (void) algo;
+#endif
+}
+
+static void run_graph(const char *label, Graph *g) {
+    int nq = (int) (sizeof(queues) / sizeof(queues[0]));
+    long long *dist = (long long*) malloc(g->n * sizeof(long long));
+    long long *ref = (long long*) malloc(g->n * sizeof(long long));
+    RunStats st;
+
+    printf("\n%s: %d vertices, %ld arcs\n", label, g->n, g->m);
+    printf("%-8s %-10s %8s %12s %12s %12s %10s\n", "algo", "queue", "time s", "inserts",
+           "decr-keys", "pops", "queue MB");
+    for (int i = 0; i < nq; ++i) {
+        fib_stats_reset();
+        fib_trace_reset();
+        dijkstra(g, 0, &queues[i], i == 0 ? ref : dist, &st);
+        int ok = i == 0 || memcmp(ref, dist, g->n * sizeof(long long)) == 0;
+        print_row("dijkstra", queues[i].name, &st, ok);
+        if (i == 0) fib_report("dijkstra");
+    }
+    long long weight0 = 0;
+    for (int i = 0; i < nq; ++i) {
+        if (queues[i].monotone_only) continue;
+        fib_stats_reset();
+        fib_trace_reset();
+        long long w = prim(g, 0, &queues[i], dist, &st);
+        if (i == 0) weight0 = w;
+        print_row("prim", queues[i].name, &st, w == weight0);
+        if (i == 0) fib_report("prim");
+    }
+    printf("spanning tree weight %lld\n", weight0);
+    free(dist);
+    free(ref);
+}
+
+int main(int argc, char **argv) {
+    const char *what = argc > 1 ? argv[1] : "both";
+    int n = argc > 2 ? (int) atof(argv[2]) : 1000000;
+    int degree = argc > 3 ? atoi(argv[3]) : 4;
+    if (n < 2) n = 2;
+
+    if (strcmp(what, "grid") == 0 || strcmp(what, "both") == 0) {
+        Graph *g = make_grid(n);
+        run_graph("grid (road-like)", g);
+        free_graph(g);
+    }
+    if (strcmp(what, "random") == 0 || strcmp(what, "both") == 0) {
+        Graph *g = make_random(n, degree);
+        run_graph("random", g);
+        free_graph(g);
+    }
+    if (strcmp(what, "grid") != 0 && strcmp(what, "random") != 0 && strcmp(what, "both") != 0) {
+        Graph *g = load_dimacs(what);
+        if (g == NULL) {
+            printf("Cannot read DIMACS graph %s\n", what);
+            return 1;
+        }
+        run_graph(what, g);
+        free_graph(g);
+    }
+
+    struct rusage ru;
+    getrusage(RUSAGE_SELF, &ru);
+    printf("\nprocess peak RSS %.1f MB\n", ru.ru_maxrss / 1024.0);
+    return 0;
+}
@@ -1,9 +1,12 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
 
 /*
  Splay Tree - single-file C implementation
  - First asks for number of nodes and reads that many keys to build the tree.
+   The initial keys are sorted and built into a perfectly balanced tree in
+   O(n) (build_from_keys), with all nodes allocated from one block.
  - Then provides the interactive menu (insert/search/delete/traversals/print).
  Compile:
    gcc -o splay_tree splay_tree.c
@@ -16,6 +19,15 @@ typedef struct Node {
     struct Node *left, *right, *parent;
 } Node;
 
+/* All nodes of one bulk build. The block belongs to the tree built from
+   it: build_from_sorted hands it back next to the root, and the caller
+   passes it to delete_key and free_tree of that tree. Nodes inserted
+   later are malloced one by one as usual. */
+typedef struct NodeBlock {
+    int size;
+    Node nodes[];
+} NodeBlock;
+
 /* helper to create node */
 Node* new_node(int key) {
     Node *n = (Node*) malloc(sizeof(Node));
@@ -24,6 +36,16 @@ Node* new_node(int key) {
     return n;
 }
 
+/* free a node unless it lives in the tree's block (block may be NULL);
+   compared as integers, since n may come from a different allocation */
+void release_node(Node *n, const NodeBlock *block) {
+    if (block) {
+        uintptr_t p = (uintptr_t) n, lo = (uintptr_t) block->nodes;
+        if (p >= lo && p - lo < (uintptr_t) block->size * sizeof(Node)) return;
+    }
+    free(n);
+}
+
 /* Right rotate x (x becomes right child of its left) */
 void rotate_right(Node **root, Node *x) {
     Node *y = x->left;
@@ -141,7 +163,7 @@ Node* join_trees(Node *L, Node *R) {
 }
 
 /* Delete key: search and remove root if matches */
-void delete_key(Node **root, int key) {
+void delete_key(Node **root, int key, const NodeBlock *block) {
     Node *node = search(root, key);
     if (!node || node->key != key) {
         printf("Key %d not found, cannot delete.\n", key);
@@ -152,10 +174,51 @@ void delete_key(Node **root, int key) {
     Node *R = node->right;
     if (L) L->parent = NULL;
     if (R) R->parent = NULL;
-    free(node);
+    release_node(node, block);
     *root = join_trees(L, R);
 }
 
+/* Balanced subtree from nodes[lo..hi] (keys already in place), with parent pointers */
+static Node* link_balanced(Node *nodes, int lo, int hi, Node *parent) {
+    if (lo > hi) return NULL;
+    int mid = lo + (hi - lo) / 2;
+    Node *n = &nodes[mid];
+    n->parent = parent;
+    n->left = link_balanced(nodes, lo, mid - 1, n);
+    n->right = link_balanced(nodes, mid + 1, hi, n);
+    return n;
+}
+
+/* Build a perfectly balanced tree from strictly increasing keys in O(n).
+   All nodes come from one new block, returned in *block; free_tree
+   releases it together with the tree. */
+Node* build_from_sorted(const int *keys, int n, NodeBlock **block) {
+    *block = NULL;
+    if (n <= 0) return NULL;
+    NodeBlock *b = (NodeBlock*) malloc(sizeof(NodeBlock) + sizeof(Node) * n);
+    if (!b) return NULL;
+    b->size = n;
+    for (int i = 0; i < n; ++i) b->nodes[i].key = keys[i];
+    *block = b;
+    return link_balanced(b->nodes, 0, n - 1, NULL);
+}
+
+static int cmp_int(const void *a, const void *b) {
+    int x = *(const int*) a, y = *(const int*) b;
+    return (x > y) - (x < y);
+}
+
+/* Unsorted input: sort, drop duplicates, then build. keys is reordered. */
+Node* build_from_keys(int *keys, int n, NodeBlock **block) {
+    *block = NULL;
+    if (n <= 0) return NULL;
+    qsort(keys, n, sizeof(int), cmp_int);
+    int m = 1;
+    for (int i = 1; i < n; ++i)
+        if (keys[i] != keys[m - 1]) keys[m++] = keys[i];
+    return build_from_sorted(keys, m, block);
+}
+
 /* Traversals */
 void inorder(Node *root) {
     if (!root) return;
@@ -180,12 +243,22 @@ void print_tree(Node *root, int depth) {
     print_tree(root->left, depth + 1);
 }
 
-/* Free all nodes */
-void free_tree(Node *root) {
-    if (!root) return;
-    free_tree(root->left);
-    free_tree(root->right);
-    free(root);
+/* Free all nodes and the tree's block. No recursion: rotate the left
+   child up until the root has none, then free the root. */
+void free_tree(Node *root, NodeBlock *block) {
+    while (root) {
+        if (root->left) {
+            Node *l = root->left;
+            root->left = l->right;
+            l->right = root;
+            root = l;
+        } else {
+            Node *right = root->right;
+            release_node(root, block);
+            root = right;
+        }
+    }
+    free(block);
 }
 
 /* Robust read integer from stdin using fgets + sscanf */
@@ -199,6 +272,7 @@ int read_int(const char *prompt, int *out) {
 
 int main() {
     Node *root = NULL;
+    NodeBlock *block = NULL; /* nodes of the initial bulk build */
 
     /* --- New: read number of nodes and build tree --- */
     int n;
@@ -208,13 +282,17 @@ int main() {
         printf("No initial nodes (or invalid number). Continuing with empty tree.\n");
     } else {
         printf("Enter %d integer keys (one per line or space-separated):\n", n);
+        int *keys = (int*) malloc(sizeof(int) * n);
+        int count = 0;
         for (int i = 0; i < n; ++i) {
             int k;
             int rr = read_int(NULL, &k);
             if (rr == 0) { printf("Input ended unexpectedly.\n"); break; }
             if (rr < 0) { printf("Invalid input, skipping.\n"); i--; continue; }
-            insert(&root, k); /* each insert splays the inserted node to root */
+            keys[count++] = k;
         }
+        root = build_from_keys(keys, count, &block); /* sort + O(n) balanced build */
+        free(keys);
         printf("Initial tree built. Current root: %s\n", root ? (char[32]){0} : "NULL");
         if (root) {
             /* avoid calling sprintf into compound literal; print separately */
@@ -250,7 +328,7 @@ int main() {
             } else printf("Invalid input.\n");
         } else if (opt == 3) {
             int k; if (read_int("Enter key to delete: ", &k) == 1) {
-                delete_key(&root, k);
+                delete_key(&root, k, block);
             } else printf("Invalid input.\n");
         } else if (opt == 4) {
             printf("Inorder: ");
@@ -273,7 +351,7 @@ int main() {
         }
     }
 
-    free_tree(root);
+    free_tree(root, block);
     printf("Goodbye.\n");
     return 0;
 }
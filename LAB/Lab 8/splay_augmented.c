@@ -0,0 +1,460 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <limits.h>
+#include <time.h>
+
+/*
+ Splay tree with public split/join and subtree augmentation
+ - Same bottom-up splay as splay.c (parent pointers), plus a value per key.
+ - split(root, key, &L, &R) and join(L, R) are public operations.
+ - With AUGMENT (on by default) every node also keeps the size, sum,
+   min and max of the values in its subtree. rotate_left/rotate_right
+   recompute them for the two nodes whose subtrees change, which makes
+     range_sum / range_stats, rank, select_kth, range_delete
+   O(log n) amortized: split off the range, read its root, join back.
+ Compile:
+   gcc -O2 -o splay_augmented splay_augmented.c
+   gcc -O2 -DAUGMENT=0 -o splay_plain splay_augmented.c   (split/join only)
+ Run:
+   ./splay_augmented [keys] [queries]
+*/
+
+#ifndef AUGMENT
+#define AUGMENT 1
+#endif
+
+typedef struct Node {
+    int key;
+    int val;
+    struct Node *left, *right, *parent;
+#if AUGMENT
+    int size;           /* nodes in this subtree */
+    long long sum;      /* sum of val over the subtree */
+    int min, max;       /* min / max of val over the subtree */
+#endif
+} Node;
+
+/* Recompute the augmented fields of x from its children */
+static inline void update(Node *x) {
+#if AUGMENT
+    x->size = 1;
+    x->sum = x->val;
+    x->min = x->max = x->val;
+    if (x->left) {
+        x->size += x->left->size;
+        x->sum += x->left->sum;
+        if (x->left->min < x->min) x->min = x->left->min;
+        if (x->left->max > x->max) x->max = x->left->max;
+    }
+    if (x->right) {
+        x->size += x->right->size;
+        x->sum += x->right->sum;
+        if (x->right->min < x->min) x->min = x->right->min;
+        if (x->right->max > x->max) x->max = x->right->max;
+    }
+#else
+    (void) x;
+#endif
+}
+
+Node* new_node(int key, int val) {
+    Node *n = (Node*) malloc(sizeof(Node));
+    n->key = key;
+    n->val = val;
+    n->left = n->right = n->parent = NULL;
+    update(n);
+    return n;
+}
+
+/* Right rotate x (x becomes right child of its left) */
+void rotate_right(Node **root, Node *x) {
+    Node *y = x->left;
+    if (!y) return;
+    x->left = y->right;
+    if (y->right) y->right->parent = x;
+    y->parent = x->parent;
+    if (!x->parent) *root = y;
+    else if (x == x->parent->left) x->parent->left = y;
+    else x->parent->right = y;
+    y->right = x;
+    x->parent = y;
+    update(x);
+    update(y);
+}
+
+/* Left rotate x (x becomes left child of its right) */
+void rotate_left(Node **root, Node *x) {
+    Node *y = x->right;
+    if (!y) return;
+    x->right = y->left;
+    if (y->left) y->left->parent = x;
+    y->parent = x->parent;
+    if (!x->parent) *root = y;
+    else if (x == x->parent->left) x->parent->left = y;
+    else x->parent->right = y;
+    y->left = x;
+    x->parent = y;
+    update(x);
+    update(y);
+}
+
+/* Splay x to root */
+void splay(Node **root, Node *x) {
+    if (!x) return;
+    while (x->parent) {
+        Node *p = x->parent;
+        Node *g = p->parent;
+        if (!g) {
+            if (x == p->left) rotate_right(root, p);
+            else rotate_left(root, p);
+        } else if ((x == p->left) && (p == g->left)) {
+            rotate_right(root, g);
+            rotate_right(root, p);
+        } else if ((x == p->right) && (p == g->right)) {
+            rotate_left(root, g);
+            rotate_left(root, p);
+        } else if ((x == p->right) && (p == g->left)) {
+            rotate_left(root, p);
+            rotate_right(root, g);
+        } else {
+            rotate_right(root, p);
+            rotate_left(root, g);
+        }
+    }
+}
+
+/* Insert key with val (or overwrite val) and splay it to the root */
+Node* insert(Node **root, int key, int val) {
+    Node *cur = *root, *parent = NULL;
+    while (cur) {
+        parent = cur;
+        if (key < cur->key) cur = cur->left;
+        else if (key > cur->key) cur = cur->right;
+        else {
+            cur->val = val;
+            update(cur);
+            splay(root, cur);   /* rotations refresh the ancestors */
+            return cur;
+        }
+    }
+    Node *n = new_node(key, val);
+    n->parent = parent;
+    if (!parent) *root = n;
+    else if (key < parent->key) parent->left = n;
+    else parent->right = n;
+    splay(root, n);
+    return n;
+}
+
+/* Find node with key. Found or not, the last accessed node is splayed. */
+Node* search(Node **root, int key) {
+    Node *cur = *root, *last = NULL;
+    while (cur) {
+        last = cur;
+        if (key == cur->key) break;
+        cur = key < cur->key ? cur->left : cur->right;
+    }
+    if (last) splay(root, last);
+    return cur;
+}
+
+/* Join two trees: all keys in L < keys in R. Returns the new root. */
+Node* join(Node *L, Node *R) {
+    if (!L) {
+        if (R) R->parent = NULL;
+        return R;
+    }
+    L->parent = NULL;
+    Node *cur = L;
+    while (cur->right) cur = cur->right;
+    splay(&L, cur);   /* max of L is the root, with no right child */
+    L->right = R;
+    if (R) R->parent = L;
+    update(L);
+    return L;
+}
+
+/* Split into L (keys < key) and R (keys >= key) */
+void split(Node *root, int key, Node **L, Node **R) {
+    if (!root) {
+        *L = *R = NULL;
+        return;
+    }
+    search(&root, key);   /* root is now key's predecessor or successor */
+    if (root->key >= key) {
+        *L = root->left;
+        if (*L) (*L)->parent = NULL;
+        root->left = NULL;
+        *R = root;
+    } else {
+        *R = root->right;
+        if (*R) (*R)->parent = NULL;
+        root->right = NULL;
+        *L = root;
+    }
+    update(root);
+}
+
+/* free without recursion: rotate the left child up until the root has
+   none, then free the root and continue with its right subtree */
+void free_tree(Node *root) {
+    while (root) {
+        if (root->left) {
+            Node *l = root->left;
+            root->left = l->right;
+            l->right = root;
+            root = l;
+        } else {
+            Node *right = root->right;
+            free(root);
+            root = right;
+        }
+    }
+}
+
+/* Delete key: split it out and join the remaining halves */
+void delete_key(Node **root, int key) {
+    Node *L, *R;
+    split(*root, key, &L, &R);
+    if (R && (search(&R, key), R->key == key)) {
+        Node *rest = R->right;
+        if (rest) rest->parent = NULL;
+        free(R);
+        R = rest;
+    }
+    *root = join(L, R);
+}
+
+#if AUGMENT
+/* Cut [lo, hi] out of *root: *A < lo <= *M <= hi < *C */
+static void split3(Node *root, int lo, int hi, Node **A, Node **M, Node **C) {
+    Node *B;
+    split(root, lo, A, &B);
+    if (hi == INT_MAX) {
+        *M = B;
+        *C = NULL;
+    } else {
+        split(B, hi + 1, M, C);
+    }
+}
+
+/* count, sum, min and max of the values with keys in [lo, hi] */
+int range_stats(Node **root, int lo, int hi, long long *sum, int *min, int *max) {
+    Node *A, *M, *C;
+    if (lo > hi) return 0;
+    split3(*root, lo, hi, &A, &M, &C);
+    int count = M ? M->size : 0;
+    if (M) {
+        if (sum) *sum = M->sum;
+        if (min) *min = M->min;
+        if (max) *max = M->max;
+    }
+    *root = join(join(A, M), C);
+    return count;
+}
+
+long long range_sum(Node **root, int lo, int hi) {
+    long long sum = 0;
+    range_stats(root, lo, hi, &sum, NULL, NULL);
+    return sum;
+}
+
+/* Number of keys smaller than key */
+int rank(Node **root, int key) {
+    Node *L, *R;
+    split(*root, key, &L, &R);
+    int r = L ? L->size : 0;
+    *root = join(L, R);
+    return r;
+}
+
+/* k-th smallest key (1-based); the node is splayed to the root */
+Node* select_kth(Node **root, int k) {
+    Node *cur = *root;
+    if (!cur || k < 1 || k > cur->size) return NULL;
+    while (cur) {
+        int left = cur->left ? cur->left->size : 0;
+        if (k == left + 1) break;
+        if (k <= left) cur = cur->left;
+        else {
+            k -= left + 1;
+            cur = cur->right;
+        }
+    }
+    splay(root, cur);
+    return cur;
+}
+
+/* Remove all keys in [lo, hi]; returns how many were removed */
+int range_delete(Node **root, int lo, int hi) {
+    Node *A, *M, *C;
+    if (lo > hi) return 0;
+    split3(*root, lo, hi, &A, &M, &C);
+    int removed = M ? M->size : 0;
+    free_tree(M);
+    *root = join(A, C);
+    return removed;
+}
+#endif
+
+/* Traversals */
+void inorder(Node *root) {
+    if (!root) return;
+    inorder(root->left);
+    printf("%d ", root->key);
+    inorder(root->right);
+}
+
+#if AUGMENT
+/* ---------- O(n) in-order walks, for comparison ---------- */
+
+static void walk_sum(Node *n, int lo, int hi, long long *sum) {
+    if (!n) return;
+    walk_sum(n->left, lo, hi, sum);
+    if (n->key >= lo && n->key <= hi) *sum += n->val;
+    walk_sum(n->right, lo, hi, sum);
+}
+
+static void walk_rank(Node *n, int key, int *count) {
+    if (!n) return;
+    walk_rank(n->left, key, count);
+    if (n->key < key) (*count)++;
+    walk_rank(n->right, key, count);
+}
+
+static void walk_select(Node *n, int *k, int *key) {
+    if (!n || *k <= 0) return;
+    walk_select(n->left, k, key);
+    if (*k > 0 && --(*k) == 0) *key = n->key;
+    walk_select(n->right, k, key);
+}
+
+static void walk_collect(Node *n, int lo, int hi, int *out, int *count) {
+    if (!n) return;
+    walk_collect(n->left, lo, hi, out, count);
+    if (n->key >= lo && n->key <= hi) out[(*count)++] = n->key;
+    walk_collect(n->right, lo, hi, out, count);
+}
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+#endif
+
+int main(int argc, char **argv) {
+    Node *root = NULL;
+
+    int demo[] = {50, 30, 70, 20, 40, 60, 80};
+    for (int i = 0; i < 7; ++i) insert(&root, demo[i], demo[i] / 10);
+    Node *L, *R;
+    split(root, 45, &L, &R);
+    printf("split(45): L = "); inorder(L);
+    printf("| R = "); inorder(R);
+    root = join(L, R);
+    delete_key(&root, 20);
+    printf("\nAfter deleting 20: "); inorder(root);
+    printf("\n");
+#if AUGMENT
+    long long s;
+    int mn, mx;
+    int c = range_stats(&root, 30, 60, &s, &mn, &mx);
+    printf("keys in [30, 60]: count %d, sum %lld, min %d, max %d\n", c, s, mn, mx);
+    printf("rank(60) = %d, select_kth(2) = %d\n", rank(&root, 60), select_kth(&root, 2)->key);
+    printf("range_delete(35, 65) removed %d: ", range_delete(&root, 35, 65));
+    inorder(root);
+    printf("\n");
+#endif
+    free_tree(root);
+
+#if AUGMENT
+    /* n keys inserted in random order, value = key % 1000 */
+    int n = argc > 1 ? atoi(argv[1]) : 1000000;
+    int q = argc > 2 ? atoi(argv[2]) : 200;
+    root = NULL;
+    srand(11);
+    int *keys = (int*) malloc(sizeof(int) * n);
+    for (int i = 0; i < n; ++i) keys[i] = i * 3;
+    for (int i = n - 1; i > 0; --i) {
+        int j = (int)((((unsigned long) rand() << 16) ^ (unsigned long) rand()) % (unsigned long)(i + 1));
+        int t = keys[i]; keys[i] = keys[j]; keys[j] = t;
+    }
+    for (int i = 0; i < n; ++i) insert(&root, keys[i], keys[i] % 1000);
+
+    int *lo = (int*) malloc(sizeof(int) * q);
+    int *hi = (int*) malloc(sizeof(int) * q);
+    for (int i = 0; i < q; ++i) {
+        lo[i] = rand() % (3 * n);
+        hi[i] = lo[i] + rand() % (3 * n / 10 + 1);
+    }
+
+    int ok = 1;
+    for (int i = 0; i < q && i < 20; ++i) {
+        long long ws = 0;
+        int wr = 0, k = lo[i] % n + 1, wk = -1;
+        walk_sum(root, lo[i], hi[i], &ws);
+        walk_rank(root, lo[i], &wr);
+        walk_select(root, &k, &wk);
+        ok &= ws == range_sum(&root, lo[i], hi[i]);
+        ok &= wr == rank(&root, lo[i]);
+        ok &= wk == select_kth(&root, lo[i] % n + 1)->key;
+    }
+    printf("\nCross-check with in-order walks: %s\n", ok ? "OK" : "FAILED");
+
+    printf("%d keys, %d queries\n", n, q);
+    printf("%-14s %16s %16s %10s\n", "query", "splay (ns/op)", "walk (ns/op)", "speedup");
+    const char *names[] = {"range_sum", "rank", "select_kth"};
+    for (int op = 0; op < 3; ++op) {
+        volatile long long sink = 0;
+        int reps = 100;
+        double t0 = now_sec();
+        for (int r = 0; r < reps; ++r)
+            for (int i = 0; i < q; ++i) {
+                if (op == 0) sink += range_sum(&root, lo[i], hi[i]);
+                else if (op == 1) sink += rank(&root, lo[i]);
+                else sink += select_kth(&root, lo[i] % n + 1)->key;
+            }
+        double t_splay = (now_sec() - t0) / ((double) reps * q) * 1e9;
+
+        t0 = now_sec();
+        for (int i = 0; i < q; ++i) {
+            long long ws = 0;
+            int wr = 0, k = lo[i] % n + 1, wk = 0;
+            if (op == 0) walk_sum(root, lo[i], hi[i], &ws);
+            else if (op == 1) walk_rank(root, lo[i], &wr);
+            else walk_select(root, &k, &wk);
+            sink += ws + wr + wk;
+        }
+        double t_walk = (now_sec() - t0) / q * 1e9;
+        printf("%-14s %16.1f %16.1f %10.0f\n", names[op], t_splay, t_walk, t_walk / t_splay);
+    }
+
+    /* range delete vs walk + one delete_key per key, on narrow ranges */
+    int *buf = (int*) malloc(sizeof(int) * n);
+    double t0 = now_sec();
+    for (int i = 0; i < q / 2; ++i)
+        range_delete(&root, lo[i], lo[i] + 3000);
+    double t_fast = now_sec() - t0;
+    t0 = now_sec();
+    for (int i = q / 2; i < q; ++i) {
+        int cnt = 0;
+        walk_collect(root, lo[i], lo[i] + 3000, buf, &cnt);
+        for (int j = 0; j < cnt; ++j) delete_key(&root, buf[j]);
+    }
+    double t_slow = now_sec() - t0;
+    printf("%-14s %16.1f %16.1f %10.0f   (ns per range, ~1000 keys each)\n", "range_delete",
+           t_fast / (q / 2) * 1e9, t_slow / (q - q / 2) * 1e9,
+           (t_slow / (q - q / 2)) / (t_fast / (q / 2)));
+
+    free(buf);
+    free(lo);
+    free(hi);
+    free(keys);
+    free_tree(root);
+#else
+    (void) argc;
+    (void) argv;
+#endif
+    return 0;
+}
@@ -0,0 +1,315 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+
+/*
+ Splay tree with configurable splay policies for read-heavy workloads
+ - SPLAY_FULL:   classic bottom-up splay of splay.c on every access.
+ - SPLAY_SEMI:   semi-splaying. A zig-zig step rotates only at the
+                 grandparent and continues from the parent, so the
+                 accessed node climbs about half way and each step
+                 does one rotation instead of two.
+ - SPLAY_DEPTH:  splay only when the accessed node is deeper than
+                 depth_threshold; hits in a shallow working set leave
+                 the tree untouched.
+ - SPLAY_RANDOM: splay with probability p, otherwise just read.
+ The policy applies to search(); insert() always splays the new node.
+ Every rotation is counted so the benchmark can report write traffic.
+ Compile:
+   gcc -O2 -o splay_policies splay_policies.c -lm
+ Run:
+   ./splay_policies [keys] [accesses] [zipf_exponent]
+*/
+
+typedef struct Node {
+    int key;
+    struct Node *left, *right, *parent;
+} Node;
+
+typedef enum { SPLAY_FULL, SPLAY_SEMI, SPLAY_DEPTH, SPLAY_RANDOM } SplayMode;
+
+typedef struct SplayPolicy {
+    SplayMode mode;
+    int depth_threshold;   /* SPLAY_DEPTH: splay only below this depth */
+    double probability;    /* SPLAY_RANDOM: chance of splaying an access */
+} SplayPolicy;
+
+static long rotations = 0;
+static unsigned long long rng_state = 88172645463325252ULL;
+
+static unsigned long long rng_next(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return rng_state;
+}
+
+static double rng_uniform(void) {
+    return (rng_next() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+Node* new_node(int key) {
+    Node *n = (Node*) malloc(sizeof(Node));
+    n->key = key;
+    n->left = n->right = n->parent = NULL;
+    return n;
+}
+
+/* Right rotate x (x becomes right child of its left) */
+void rotate_right(Node **root, Node *x) {
+    Node *y = x->left;
+    if (!y) return;
+    rotations++;
+    x->left = y->right;
+    if (y->right) y->right->parent = x;
+    y->parent = x->parent;
+    if (!x->parent) *root = y;
+    else if (x == x->parent->left) x->parent->left = y;
+    else x->parent->right = y;
+    y->right = x;
+    x->parent = y;
+}
+
+/* Left rotate x (x becomes left child of its right) */
+void rotate_left(Node **root, Node *x) {
+    Node *y = x->right;
+    if (!y) return;
+    rotations++;
+    x->right = y->left;
+    if (y->left) y->left->parent = x;
+    y->parent = x->parent;
+    if (!x->parent) *root = y;
+    else if (x == x->parent->left) x->parent->left = y;
+    else x->parent->right = y;
+    y->left = x;
+    x->parent = y;
+}
+
+/* Rotate x above its parent */
+static void rotate_up(Node **root, Node *x) {
+    if (x == x->parent->left) rotate_right(root, x->parent);
+    else rotate_left(root, x->parent);
+}
+
+/* Splay x to root */
+void splay(Node **root, Node *x) {
+    if (!x) return;
+    while (x->parent) {
+        Node *p = x->parent;
+        Node *g = p->parent;
+        if (!g) {
+            rotate_up(root, x);                            /* Zig */
+        } else if ((x == p->left) == (p == g->left)) {
+            rotate_up(root, p);                            /* Zig-Zig */
+            rotate_up(root, x);
+        } else {
+            rotate_up(root, x);                            /* Zig-Zag */
+            rotate_up(root, x);
+        }
+    }
+}
+
+/* Semi-splay x: zig-zig rotates the parent only and continues from it */
+void semi_splay(Node **root, Node *x) {
+    if (!x) return;
+    while (x->parent) {
+        Node *p = x->parent;
+        Node *g = p->parent;
+        if (!g) {
+            rotate_up(root, x);
+        } else if ((x == p->left) == (p == g->left)) {
+            rotate_up(root, p);
+            x = p;
+        } else {
+            rotate_up(root, x);
+            rotate_up(root, x);
+        }
+    }
+}
+
+/* Insert key and splay it to the root */
+Node* insert(Node **root, int key) {
+    Node *cur = *root, *parent = NULL;
+    while (cur) {
+        parent = cur;
+        if (key < cur->key) cur = cur->left;
+        else if (key > cur->key) cur = cur->right;
+        else {
+            splay(root, cur);
+            return cur;
+        }
+    }
+    Node *n = new_node(key);
+    n->parent = parent;
+    if (!parent) *root = n;
+    else if (key < parent->key) parent->left = n;
+    else parent->right = n;
+    splay(root, n);
+    return n;
+}
+
+/* Search, restructuring according to the policy. Returns the node or NULL. */
+Node* search(Node **root, int key, const SplayPolicy *policy) {
+    Node *cur = *root, *last = NULL;
+    int depth = 0;
+    while (cur) {
+        last = cur;
+        if (key == cur->key) break;
+        cur = key < cur->key ? cur->left : cur->right;
+        depth++;
+    }
+    if (!last) return NULL;
+    switch (policy->mode) {
+    case SPLAY_FULL:
+        splay(root, last);
+        break;
+    case SPLAY_SEMI:
+        semi_splay(root, last);
+        break;
+    case SPLAY_DEPTH:
+        if (depth > policy->depth_threshold) splay(root, last);
+        break;
+    case SPLAY_RANDOM:
+        if (rng_uniform() < policy->probability) splay(root, last);
+        break;
+    }
+    return cur;
+}
+
+/* free without recursion: rotate the left child up until the root has
+   none, then free the root and continue with its right subtree */
+void free_tree(Node *root) {
+    while (root) {
+        if (root->left) {
+            Node *l = root->left;
+            root->left = l->right;
+            l->right = root;
+            root = l;
+        } else {
+            Node *right = root->right;
+            free(root);
+            root = right;
+        }
+    }
+}
+
+/* depth-first with an explicit stack: sequential inserts can make the
+   tree a path as deep as n */
+static int tree_height(Node *root) {
+    if (!root) return 0;
+    int cap = 64, top = 0, height = 0;
+    Node **stack = (Node**) malloc(cap * sizeof(Node*));
+    int *depth = (int*) malloc(cap * sizeof(int));
+    stack[top] = root;
+    depth[top++] = 1;
+    while (top > 0) {
+        Node *n = stack[--top];
+        int d = depth[top];
+        if (d > height) height = d;
+        if (top + 2 > cap) {
+            cap *= 2;
+            stack = (Node**) realloc(stack, cap * sizeof(Node*));
+            depth = (int*) realloc(depth, cap * sizeof(int));
+        }
+        if (n->left) { stack[top] = n->left; depth[top++] = d + 1; }
+        if (n->right) { stack[top] = n->right; depth[top++] = d + 1; }
+    }
+    free(stack);
+    free(depth);
+    return height;
+}
+
+/* ---------- read-mostly benchmark ---------- */
+
+/* zipfian ranks mapped through a random permutation onto even keys */
+static int* zipf_trace(int n, int m, double s) {
+    double *cdf = (double*) malloc(sizeof(double) * n);
+    int *perm = (int*) malloc(sizeof(int) * n);
+    int *trace = (int*) malloc(sizeof(int) * m);
+    double sum = 0;
+    for (int i = 0; i < n; ++i) {
+        sum += 1.0 / pow(i + 1, s);
+        cdf[i] = sum;
+        perm[i] = i;
+    }
+    for (int i = n - 1; i > 0; --i) {
+        int j = (int)(rng_next() % (unsigned long long)(i + 1));
+        int t = perm[i]; perm[i] = perm[j]; perm[j] = t;
+    }
+    for (int i = 0; i < m; ++i) {
+        double u = rng_uniform() * sum;
+        int lo = 0, hi = n - 1;
+        while (lo < hi) {
+            int mid = (lo + hi) / 2;
+            if (cdf[mid] < u) lo = mid + 1;
+            else hi = mid;
+        }
+        trace[i] = perm[lo] * 2;
+    }
+    free(cdf);
+    free(perm);
+    return trace;
+}
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+int main(int argc, char **argv) {
+    int n = argc > 1 ? atoi(argv[1]) : 1000000;
+    int m = argc > 2 ? atoi(argv[2]) : 5000000;
+    double s = argc > 3 ? atof(argv[3]) : 0.99;
+    int log_n = (int) ceil(log2(n > 1 ? n : 2));
+
+    SplayPolicy policies[] = {
+        {SPLAY_FULL, 0, 0},
+        {SPLAY_SEMI, 0, 0},
+        {SPLAY_DEPTH, 2 * log_n, 0},
+        {SPLAY_DEPTH, 3 * log_n, 0},
+        {SPLAY_RANDOM, 0, 0.1},
+        {SPLAY_RANDOM, 0, 0.01},
+    };
+    const char *names[] = {"full", "semi", "depth>2log n", "depth>3log n", "random p=0.1", "random p=0.01"};
+    int npolicies = 6;
+
+    int *keys = (int*) malloc(sizeof(int) * n);
+    for (int i = 0; i < n; ++i) keys[i] = i * 2;
+    for (int i = n - 1; i > 0; --i) {
+        int j = (int)(rng_next() % (unsigned long long)(i + 1));
+        int t = keys[i]; keys[i] = keys[j]; keys[j] = t;
+    }
+    int *trace = zipf_trace(n, m, s);
+
+    printf("%d keys, %d accesses (zipf s = %.2f), 95%% search / 5%% insert of new keys\n", n, m, s);
+    printf("%-15s %12s %14s %12s %8s\n", "policy", "Mops/s", "rot/lookup", "hits", "height");
+    for (int k = 0; k < npolicies; ++k) {
+        Node *root = NULL;
+        for (int i = 0; i < n; ++i) insert(&root, keys[i]);
+
+        long hits = 0, lookups = 0, rot_lookups = 0;
+        int next_new = 1;   /* odd keys are new */
+        double t0 = now_sec();
+        for (int i = 0; i < m; ++i) {
+            if (i % 20 == 19) {
+                insert(&root, next_new);
+                next_new += 2;
+            } else {
+                long before = rotations;
+                hits += search(&root, trace[i], &policies[k]) != NULL;
+                rot_lookups += rotations - before;
+                lookups++;
+            }
+        }
+        double t = now_sec() - t0;
+        printf("%-15s %12.2f %14.2f %12ld %8d\n", names[k], m / t / 1e6,
+               (double) rot_lookups / lookups, hits, tree_height(root));
+        free_tree(root);
+    }
+
+    free(keys);
+    free(trace);
+    return 0;
+}
@@ -0,0 +1,371 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+
+/*
+ Top-down splay tree (no parent pointers)
+ - splay() restructures the tree during the single search descent,
+   hanging the nodes it passes on a left and a right assembly tree and
+   reassembling them around the found node at the end.
+ - Nodes need no parent field: 16 bytes of links instead of 24.
+ - main() benchmarks it against the bottom-up splay of splay.c on
+   zipfian access traces.
+ Compile:
+   gcc -O2 -o splay_topdown splay_topdown.c -lm
+ Run:
+   ./splay_topdown [keys] [accesses] [zipf_exponent]
+*/
+
+typedef struct Node {
+    int key;
+    struct Node *left, *right;
+} Node;
+
+Node* new_node(int key) {
+    Node *n = (Node*) malloc(sizeof(Node));
+    n->key = key;
+    n->left = n->right = NULL;
+    return n;
+}
+
+/* Splay the node with key (or the last node on its search path) to the root */
+Node* splay(Node *t, int key) {
+    Node header, *l, *r, *y;
+    if (!t) return t;
+    header.left = header.right = NULL;
+    l = r = &header;   /* header.right: left tree, header.left: right tree */
+    for (;;) {
+        if (key < t->key) {
+            if (!t->left) break;
+            if (key < t->left->key) {
+                /* Zig-Zig: rotate right first */
+                y = t->left;
+                t->left = y->right;
+                y->right = t;
+                t = y;
+                if (!t->left) break;
+            }
+            /* link t into the right tree */
+            r->left = t;
+            r = t;
+            t = t->left;
+        } else if (key > t->key) {
+            if (!t->right) break;
+            if (key > t->right->key) {
+                /* Zig-Zig: rotate left first */
+                y = t->right;
+                t->right = y->left;
+                y->left = t;
+                t = y;
+                if (!t->right) break;
+            }
+            /* link t into the left tree */
+            l->right = t;
+            l = t;
+            t = t->right;
+        } else {
+            break;
+        }
+    }
+    /* reassemble */
+    l->right = t->left;
+    r->left = t->right;
+    t->left = header.right;
+    t->right = header.left;
+    return t;
+}
+
+/* Insert key (no-op if present); the key ends up at the root */
+Node* insert(Node *root, int key) {
+    if (!root) return new_node(key);
+    root = splay(root, key);
+    if (key == root->key) return root;
+    Node *n = new_node(key);
+    if (key < root->key) {
+        n->left = root->left;
+        n->right = root;
+        root->left = NULL;
+    } else {
+        n->right = root->right;
+        n->left = root;
+        root->right = NULL;
+    }
+    return n;
+}
+
+/* Search: the found (or last accessed) node becomes the root */
+Node* search(Node **root, int key) {
+    *root = splay(*root, key);
+    if (*root && (*root)->key == key) return *root;
+    return NULL;
+}
+
+/* Delete key: splay it up and join its subtrees */
+Node* delete_key(Node *root, int key) {
+    if (!root) return root;
+    root = splay(root, key);
+    if (root->key != key) return root;
+    Node *rest;
+    if (!root->left) {
+        rest = root->right;
+    } else {
+        /* the max of the left subtree has no right child after splaying */
+        rest = splay(root->left, key);
+        rest->right = root->right;
+    }
+    free(root);
+    return rest;
+}
+
+void inorder(Node *root) {
+    if (!root) return;
+    inorder(root->left);
+    printf("%d ", root->key);
+    inorder(root->right);
+}
+
+/* free without recursion: rotate the left child up until the root has
+   none, then free the root and continue with its right subtree */
+void free_tree(Node *root) {
+    while (root) {
+        if (root->left) {
+            Node *l = root->left;
+            root->left = l->right;
+            l->right = root;
+            root = l;
+        } else {
+            Node *right = root->right;
+            free(root);
+            root = right;
+        }
+    }
+}
+
+/* ---------- bottom-up splay from splay.c, for comparison ---------- */
+
+typedef struct BUNode {
+    int key;
+    struct BUNode *left, *right, *parent;
+} BUNode;
+
+BUNode* bu_new_node(int key) {
+    BUNode *n = (BUNode*) malloc(sizeof(BUNode));
+    n->key = key;
+    n->left = n->right = n->parent = NULL;
+    return n;
+}
+
+void bu_rotate_right(BUNode **root, BUNode *x) {
+    BUNode *y = x->left;
+    if (!y) return;
+    x->left = y->right;
+    if (y->right) y->right->parent = x;
+    y->parent = x->parent;
+    if (!x->parent) *root = y;
+    else if (x == x->parent->left) x->parent->left = y;
+    else x->parent->right = y;
+    y->right = x;
+    x->parent = y;
+}
+
+void bu_rotate_left(BUNode **root, BUNode *x) {
+    BUNode *y = x->right;
+    if (!y) return;
+    x->right = y->left;
+    if (y->left) y->left->parent = x;
+    y->parent = x->parent;
+    if (!x->parent) *root = y;
+    else if (x == x->parent->left) x->parent->left = y;
+    else x->parent->right = y;
+    y->left = x;
+    x->parent = y;
+}
+
+void bu_splay(BUNode **root, BUNode *x) {
+    if (!x) return;
+    while (x->parent) {
+        BUNode *p = x->parent;
+        BUNode *g = p->parent;
+        if (!g) {
+            if (x == p->left) bu_rotate_right(root, p);
+            else bu_rotate_left(root, p);
+        } else if ((x == p->left) && (p == g->left)) {
+            bu_rotate_right(root, g);
+            bu_rotate_right(root, p);
+        } else if ((x == p->right) && (p == g->right)) {
+            bu_rotate_left(root, g);
+            bu_rotate_left(root, p);
+        } else if ((x == p->right) && (p == g->left)) {
+            bu_rotate_left(root, p);
+            bu_rotate_right(root, g);
+        } else {
+            bu_rotate_right(root, p);
+            bu_rotate_left(root, g);
+        }
+    }
+}
+
+void bu_insert(BUNode **root, int key) {
+    if (*root == NULL) {
+        *root = bu_new_node(key);
+        return;
+    }
+    BUNode *cur = *root, *parent = NULL;
+    while (cur) {
+        parent = cur;
+        if (key < cur->key) cur = cur->left;
+        else if (key > cur->key) cur = cur->right;
+        else {
+            bu_splay(root, cur);
+            return;
+        }
+    }
+    BUNode *n = bu_new_node(key);
+    n->parent = parent;
+    if (key < parent->key) parent->left = n;
+    else parent->right = n;
+    bu_splay(root, n);
+}
+
+BUNode* bu_search(BUNode **root, int key) {
+    BUNode *cur = *root, *last = NULL;
+    while (cur) {
+        last = cur;
+        if (key == cur->key) {
+            bu_splay(root, cur);
+            return cur;
+        } else if (key < cur->key) cur = cur->left;
+        else cur = cur->right;
+    }
+    if (last) bu_splay(root, last);
+    return NULL;
+}
+
+/* free without recursion: rotate the left child up until the root has
+   none, then free the root and continue with its right subtree */
+void bu_free_tree(BUNode *root) {
+    while (root) {
+        if (root->left) {
+            BUNode *l = root->left;
+            root->left = l->right;
+            l->right = root;
+            root = l;
+        } else {
+            BUNode *right = root->right;
+            free(root);
+            root = right;
+        }
+    }
+}
+
+/* ---------- zipfian trace and benchmark ---------- */
+
+static unsigned long long rng_state = 88172645463325252ULL;
+static unsigned long long rng_next(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return rng_state;
+}
+
+/* Trace of m keys from {0, 2, ..., 2(n-1)}, rank r drawn with P ~ 1/r^s.
+   Ranks are mapped to keys through a random permutation so the hot
+   keys are spread over the key space. */
+int* zipf_trace(int n, int m, double s) {
+    double *cdf = (double*) malloc(sizeof(double) * n);
+    int *perm = (int*) malloc(sizeof(int) * n);
+    int *trace = (int*) malloc(sizeof(int) * m);
+    double sum = 0;
+    for (int i = 0; i < n; ++i) {
+        sum += 1.0 / pow(i + 1, s);
+        cdf[i] = sum;
+        perm[i] = i;
+    }
+    for (int i = n - 1; i > 0; --i) {
+        int j = (int)(rng_next() % (unsigned long long)(i + 1));
+        int t = perm[i]; perm[i] = perm[j]; perm[j] = t;
+    }
+    for (int i = 0; i < m; ++i) {
+        double u = (rng_next() >> 11) * (1.0 / 9007199254740992.0) * sum;
+        int lo = 0, hi = n - 1;
+        while (lo < hi) {
+            int mid = (lo + hi) / 2;
+            if (cdf[mid] < u) lo = mid + 1;
+            else hi = mid;
+        }
+        trace[i] = perm[lo] * 2;
+    }
+    free(cdf);
+    free(perm);
+    return trace;
+}
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+int main(int argc, char **argv) {
+    int n = argc > 1 ? atoi(argv[1]) : 1000000;
+    int m = argc > 2 ? atoi(argv[2]) : 5000000;
+    double skews[] = {0.8, 0.99, 1.2};
+    int nskews = 3;
+    if (argc > 3) {
+        skews[0] = atof(argv[3]);
+        nskews = 1;
+    }
+
+    Node *root = NULL;
+    int demo[] = {50, 30, 70, 20, 40, 60, 80};
+    for (int i = 0; i < 7; ++i) root = insert(root, demo[i]);
+    printf("Inorder: ");
+    inorder(root);
+    root = delete_key(root, 50);
+    printf("\nAfter deleting 50: ");
+    inorder(root);
+    printf("\nRoot after search(60): %d\n", search(&root, 60) ? root->key : -1);
+    free_tree(root);
+
+    /* both trees get the same keys in the same (random) order */
+    int *keys = (int*) malloc(sizeof(int) * n);
+    for (int i = 0; i < n; ++i) keys[i] = i * 2;
+    for (int i = n - 1; i > 0; --i) {
+        int j = (int)(rng_next() % (unsigned long long)(i + 1));
+        int t = keys[i]; keys[i] = keys[j]; keys[j] = t;
+    }
+    root = NULL;
+    BUNode *bu_root = NULL;
+    for (int i = 0; i < n; ++i) {
+        root = insert(root, keys[i]);
+        bu_insert(&bu_root, keys[i]);
+    }
+
+    printf("\n%d keys, %d accesses; node size: top-down %zu bytes, bottom-up %zu bytes\n",
+           n, m, sizeof(Node), sizeof(BUNode));
+    printf("%6s %18s %18s %10s\n", "zipf s", "bottom-up (ns/op)", "top-down (ns/op)", "speedup");
+    for (int k = 0; k < nskews; ++k) {
+        int *trace = zipf_trace(n, m, skews[k]);
+        long hits_bu = 0, hits_td = 0;
+
+        double t0 = now_sec();
+        for (int i = 0; i < m; ++i)
+            hits_bu += bu_search(&bu_root, trace[i]) != NULL;
+        double t_bu = (now_sec() - t0) / m * 1e9;
+
+        t0 = now_sec();
+        for (int i = 0; i < m; ++i)
+            hits_td += search(&root, trace[i]) != NULL;
+        double t_td = (now_sec() - t0) / m * 1e9;
+
+        if (hits_bu != hits_td || hits_td != m) printf("hit count mismatch!\n");
+        printf("%6.2f %18.1f %18.1f %10.2f\n", skews[k], t_bu, t_td, t_bu / t_td);
+        free(trace);
+    }
+
+    free(keys);
+    free_tree(root);
+    bu_free_tree(bu_root);
+    return 0;
+}